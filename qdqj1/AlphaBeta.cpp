@@ -0,0 +1,48 @@
+/**
+ * @file AlphaBeta.cpp
+ * @brief alpha-beta 搜索共用部分的实现
+ */
+
+#include "AlphaBeta.h"
+#include "CardDatabase.h"
+
+using namespace std;
+
+void AlphaBeta::orderMoves(const GameState& s, MCTSMove moves[], int n, uint8_t ttMove, bool scienceBonus) {
+    int keys[MAX_ACTIONS];
+    for (int i = 0; i < n; i++) {
+        const MCTSMove& m = moves[i];
+        int key = 0;
+        if (encodeAction({m.type, m.cardId, m.wonderIdx}) == ttMove) key = 1000;
+        else if (m.type == 3) key = 200 + CardDatabase::getWonder(s.players[s.activePlayer].wonders[m.wonderIdx]).points;
+        else if (m.type == 1) {
+            const Card& c = CardDatabase::getCard(s.slotCard[m.cardId]);
+            key = 100 + c.points + 2 * c.shields + (scienceBonus && c.science != NO_SYMBOL ? 3 : 0);
+        }
+        keys[i] = key;
+    }
+    // 插入排序：行动数很少，且大部分已大致有序
+    for (int i = 1; i < n; i++) {
+        MCTSMove m = moves[i];
+        int k = keys[i], j = i - 1;
+        for (; j >= 0 && keys[j] < k; j--) { moves[j + 1] = moves[j]; keys[j + 1] = keys[j]; }
+        moves[j + 1] = m;
+        keys[j + 1] = k;
+    }
+}
+
+bool AlphaBeta::probe(const TranspositionTable& table, uint64_t key, int depth, int alpha, int beta, uint8_t& ttMove, int& score) {
+    TTEntry e;
+    if (!table.probe(key, e)) return false;
+    ttMove = e.move;
+    if (e.depth < depth) return false;
+    score = e.score;
+    return e.bound == BOUND_EXACT
+        || (e.bound == BOUND_LOWER && e.score >= beta)
+        || (e.bound == BOUND_UPPER && e.score <= alpha);
+}
+
+void AlphaBeta::store(TranspositionTable& table, uint64_t key, int value, int alphaOrig, int beta, int depth, uint8_t move) {
+    BoundType bound = value <= alphaOrig ? BOUND_UPPER : value >= beta ? BOUND_LOWER : BOUND_EXACT;
+    table.store(key, value, depth, bound, move);
+}
@@ -0,0 +1,37 @@
+/**
+ * @file AlphaBeta.h
+ * @brief alpha-beta 搜索共用的行动排序与置换表读写
+ * 作用：期望极小化极大搜索与残局求解器都在 GameState 上做 negamax alpha-beta，
+ *      二者的行动排序、置换表剪枝与写回规则相同，集中放在这里。
+ */
+
+#ifndef ALPHABETA_H
+#define ALPHABETA_H
+
+#include "MCTS.h"
+#include "GameState.h"
+#include "TranspositionTable.h"
+#include <cstdint>
+
+class AlphaBeta {
+public:
+    static const int INF = 1 << 20;     // 大于任何分值的窗口边界
+
+    /**
+     * @brief 行动排序：置换表中的最佳行动优先，其次奇迹、建造 (分数和盾牌多的在前)、弃牌
+     * @param scienceBonus 科技卡是否额外加分 (估值函数计入科技符号时使用)
+     */
+    static void orderMoves(const GameState& s, MCTSMove moves[], int n, uint8_t ttMove, bool scienceBonus);
+
+    /**
+     * @brief 查询置换表
+     * 命中时把记下的最佳行动写入 ttMove；条目深度不小于 depth 且其界足以在 (alpha, beta) 窗口内剪枝时
+     * 返回 true 并把分值写入 score。
+     */
+    static bool probe(const TranspositionTable& table, uint64_t key, int depth, int alpha, int beta, uint8_t& ttMove, int& score);
+
+    // 按搜索结果相对原始窗口 (alphaOrig, beta) 的位置确定界类型并写回置换表
+    static void store(TranspositionTable& table, uint64_t key, int value, int alphaOrig, int beta, int depth, uint8_t move);
+};
+
+#endif
@@ -0,0 +1,301 @@
+/**
+ * @file BatchRollout.cpp
+ * @brief 批量模拟后端的实现
+ */
+
+#include "BatchRollout.h"
+#include "CardDatabase.h"
+#include "CostKernel.h"
+#include "Rollout.h"
+#include <bit>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define BATCH_ROLLOUT_AVX2 1
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+static const int NO_CHAIN_SHIFT = 32;
+
+BatchRollout::BatchRollout(RolloutPolicy policy, bool simd)
+    : policy(policy), simd(simd && simdSupported()) {}
+
+bool BatchRollout::simdSupported() {
+#ifdef BATCH_ROLLOUT_AVX2
+    return __builtin_cpu_supports("avx2");
+#else
+    return false;
+#endif
+}
+
+void BatchRollout::loadSlots(int lane) {
+    const GameState& s = state[lane];
+    for (int i = 0; i < 20; i++) {
+        const Card& c = CardDatabase::getCard(s.slotCard[i]);
+        for (int r = 0; r < 5; r++) slots.need[i][r].v[lane] = c.cost.resources[r];
+        slots.coins[i].v[lane] = c.cost.coins;
+        slots.chainCost[i].v[lane] = c.chainCost == NONE_CHAIN ? NO_CHAIN_SHIFT : c.chainCost;
+    }
+    slotAge[lane] = s.age;
+}
+
+void BatchRollout::loadWonders(int lane) {
+    const GameState& s = state[lane];
+    for (int p = 0; p < 2; p++) {
+        for (int w = 0; w < 4; w++) {
+            const PlayerState& ps = s.players[p];
+            Cost cost;
+            if (w < ps.wonderCount) cost = CardDatabase::getWonder(ps.wonders[w]).cost;
+            for (int r = 0; r < 5; r++) wonders.need[p][w][r].v[lane] = cost.resources[r];
+            wonders.coins[p][w].v[lane] = cost.coins;
+        }
+    }
+}
+
+void BatchRollout::loadDynamic(int lane) {
+    const GameState& s = state[lane];
+    int p = s.activePlayer;
+    const PlayerState& me = s.players[p];
+    const PlayerState& opp = s.players[1 - p];
+    dyn.coins.v[lane] = me.coins;
+    for (int r = 0; r < 5; r++) {
+        dyn.production[r].v[lane] = me.production[r];
+        dyn.oppProduction[r].v[lane] = opp.production[r];
+    }
+    dyn.tradeFixed.v[lane] = me.tradeFixed;
+    dyn.chainIcons.v[lane] = (int32_t)me.chainIcons;
+    dyn.architecture.v[lane] = ((me.tokens >> P_ARCHITECTURE) & 1) ? -1 : 0;
+    dyn.available[lane] = s.availableMask();
+    mover.v[lane] = p;
+}
+
+/**
+ * @brief 标量实现：逐通道调用 CostKernel，规则与 GameState::calculateCostDetails /
+ *        calculateWonderCost 完全相同
+ */
+void BatchRollout::computeScalar(uint32_t activeLanes) {
+    for (uint32_t lanes = activeLanes; lanes; lanes &= lanes - 1) {
+        int l = countr_zero(lanes);
+        uint8_t production[5], oppProduction[5], need[5];
+        for (int r = 0; r < 5; r++) {
+            production[r] = dyn.production[r].v[l];
+            oppProduction[r] = dyn.oppProduction[r].v[l];
+        }
+        TradeContext ctx = CostKernel::makeContext(production, oppProduction, dyn.tradeFixed.v[l]);
+        uint32_t chain = dyn.chainIcons.v[l];
+        int coins = dyn.coins.v[l];
+
+        uint32_t ok = 0;
+        for (uint32_t m = dyn.available[l]; m; m &= m - 1) {
+            int i = countr_zero(m);
+            int chainCost = slots.chainCost[i].v[l];
+            bool freeChain = chainCost < NO_CHAIN_SHIFT && ((chain >> chainCost) & 1);
+            for (int r = 0; r < 5; r++) need[r] = slots.need[i][r].v[l];
+            int cost = slots.coins[i].v[l] + CostKernel::tradeCost(ctx, need, 0);
+            if (freeChain || coins >= cost) ok |= 1u << i;
+        }
+        buildable[l] = ok;
+
+        int p = mover.v[l];
+        uint8_t wok = 0;
+        for (int w = 0; w < 4; w++) {
+            int cost = wonders.coins[p][w].v[l];
+            if (cost == 0) {
+                for (int r = 0; r < 5; r++) need[r] = wonders.need[p][w][r].v[l];
+                cost = CostKernel::tradeCost(ctx, need, dyn.architecture.v[l] ? 2 : 0);
+            }
+            if (coins >= cost) wok |= 1 << w;
+        }
+        wonderAffordable[l] = wok;
+    }
+}
+
+#ifdef BATCH_ROLLOUT_AVX2
+#define AVX2_FN __attribute__((target("avx2")))
+
+namespace {
+
+AVX2_FN inline __m256i load8(const int32_t* p) { return _mm256_load_si256((const __m256i*)p); }
+
+/**
+ * @brief 8 个通道的交易费用，与 CostKernel::tradeCost 逐通道相同
+ * 折扣最多 2 份、总是抵掉最贵的缺口：设有缺口的资源中最高单价为 m1、该单价下共缺 cnt1 份，
+ * 次高单价为 m2，则折扣为 cnt1 >= 2 ? 2 * m1 : m1 + m2。
+ * @param discountMask 需要折扣的通道为全 1
+ */
+AVX2_FN inline __m256i tradeCost8(const __m256i need[5], const __m256i production[5], const __m256i price[5],
+                                  __m256i discountMask) {
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i missing[5], has[5];
+    __m256i total = zero, m1 = zero;
+    for (int r = 0; r < 5; r++) {
+        missing[r] = _mm256_max_epi32(_mm256_sub_epi32(need[r], production[r]), zero);
+        has[r] = _mm256_cmpgt_epi32(missing[r], zero);
+        total = _mm256_add_epi32(total, _mm256_mullo_epi32(missing[r], price[r]));
+        m1 = _mm256_max_epi32(m1, _mm256_and_si256(has[r], price[r]));
+    }
+    if (_mm256_testz_si256(discountMask, discountMask)) return total;
+
+    __m256i cnt1 = zero, m2 = zero;
+    for (int r = 0; r < 5; r++) {
+        __m256i top = _mm256_and_si256(has[r], _mm256_cmpeq_epi32(price[r], m1));
+        cnt1 = _mm256_add_epi32(cnt1, _mm256_and_si256(top, missing[r]));
+        __m256i below = _mm256_and_si256(has[r], _mm256_cmpgt_epi32(m1, price[r]));
+        m2 = _mm256_max_epi32(m2, _mm256_and_si256(below, price[r]));
+    }
+    __m256i twoTop = _mm256_cmpgt_epi32(cnt1, _mm256_set1_epi32(1));
+    __m256i discount = _mm256_blendv_epi8(_mm256_add_epi32(m1, m2), _mm256_add_epi32(m1, m1), twoTop);
+    return _mm256_sub_epi32(total, _mm256_and_si256(discountMask, discount));
+}
+
+// 把 8 个通道的比较结果 (全 1 / 全 0) 压成 8 位掩码
+AVX2_FN inline uint32_t laneBits(__m256i mask) {
+    return (uint32_t)_mm256_movemask_ps(_mm256_castsi256_ps(mask));
+}
+
+}  // namespace
+
+AVX2_FN void BatchRollout::computeSimd(uint32_t activeLanes) {
+    const __m256i one = _mm256_set1_epi32(1);
+    for (int half = 0; half < LANES / 8; half++) {
+        int base = half * 8;
+        if (((activeLanes >> base) & 0xFF) == 0) continue;
+
+        __m256i coins = load8(dyn.coins.v + base);
+        __m256i fixed = load8(dyn.tradeFixed.v + base);
+        __m256i production[5], price[5];
+        for (int r = 0; r < 5; r++) {
+            production[r] = load8(dyn.production[r].v + base);
+            // 贸易卡固定单价 1，否则 2 + 对手产量
+            __m256i isFixed = _mm256_cmpeq_epi32(_mm256_and_si256(_mm256_srli_epi32(fixed, r), one), one);
+            __m256i open = _mm256_add_epi32(load8(dyn.oppProduction[r].v + base), _mm256_set1_epi32(2));
+            price[r] = _mm256_blendv_epi8(open, one, isFixed);
+        }
+        __m256i chain = load8(dyn.chainIcons.v + base);
+
+        uint32_t anyAvailable = 0;
+        for (int l = base; l < base + 8; l++) {
+            buildable[l] = 0;
+            if ((activeLanes >> l) & 1) anyAvailable |= dyn.available[l];
+        }
+        // 只计算至少一个通道可拿的位置
+        for (uint32_t m = anyAvailable; m; m &= m - 1) {
+            int i = countr_zero(m);
+            __m256i need[5];
+            for (int r = 0; r < 5; r++) need[r] = load8(slots.need[i][r].v + base);
+            __m256i cost = _mm256_add_epi32(load8(slots.coins[i].v + base),
+                                            tradeCost8(need, production, price, _mm256_setzero_si256()));
+            __m256i tooExpensive = _mm256_cmpgt_epi32(cost, coins);
+            __m256i freeChain = _mm256_cmpeq_epi32(
+                _mm256_and_si256(_mm256_srlv_epi32(chain, load8(slots.chainCost[i].v + base)), one), one);
+            uint32_t ok = laneBits(_mm256_or_si256(_mm256_andnot_si256(tooExpensive, _mm256_set1_epi32(-1)), freeChain));
+            for (; ok; ok &= ok - 1) buildable[base + countr_zero(ok)] |= 1u << i;
+        }
+
+        __m256i second = _mm256_cmpeq_epi32(load8(mover.v + base), one);
+        __m256i architecture = load8(dyn.architecture.v + base);
+        for (int l = base; l < base + 8; l++) wonderAffordable[l] = 0;
+        for (int w = 0; w < 4; w++) {
+            __m256i need[5];
+            for (int r = 0; r < 5; r++) {
+                need[r] = _mm256_blendv_epi8(load8(wonders.need[0][w][r].v + base),
+                                             load8(wonders.need[1][w][r].v + base), second);
+            }
+            __m256i coinCost = _mm256_blendv_epi8(load8(wonders.coins[0][w].v + base),
+                                                  load8(wonders.coins[1][w].v + base), second);
+            __m256i trade = tradeCost8(need, production, price, architecture);
+            // 直接付金币的奇迹不需要资源
+            __m256i cost = _mm256_blendv_epi8(coinCost, trade, _mm256_cmpeq_epi32(coinCost, _mm256_setzero_si256()));
+            uint32_t ok = laneBits(_mm256_cmpgt_epi32(cost, coins)) ^ 0xFF;
+            for (; ok; ok &= ok - 1) wonderAffordable[base + countr_zero(ok)] |= 1 << w;
+        }
+    }
+}
+#else
+void BatchRollout::computeSimd(uint32_t activeLanes) {
+    computeScalar(activeLanes);
+}
+#endif
+
+int BatchRollout::listMoves(int lane, MCTSMove out[]) const {
+    const GameState& s = state[lane];
+    const PlayerState& me = s.players[s.activePlayer];
+    bool wondersOpen = s.totalBuiltWonders() < 7;
+    int n = 0;
+    for (uint32_t m = dyn.available[lane]; m; m &= m - 1) {
+        int8_t id = countr_zero(m);
+        if ((buildable[lane] >> id) & 1) out[n++] = {1, id, -1};
+        out[n++] = {2, id, -1};
+        if (!wondersOpen) continue;
+        for (int8_t w = 0; w < me.wonderCount; w++) {
+            if (!((me.wondersBuilt >> w) & 1) && ((wonderAffordable[lane] >> w) & 1)) out[n++] = {3, id, w};
+        }
+    }
+    return n;
+}
+
+void BatchRollout::runStrided(const GameState* roots, size_t stride, int count, const uint64_t seeds[],
+                              RolloutOutcome out[], vector<MCTSMove>* logs) {
+    int next = 0;
+    uint32_t active = 0;
+
+    auto finish = [&](int l) {
+        const GameState& s = state[l];
+        out[job[l]] = {s.winner, s.victory, (int16_t)s.calculateScore(0), (int16_t)s.calculateScore(1), moveCount[l]};
+    };
+    // 给空闲通道分配下一局；起始局面已结束的直接记结果
+    auto start = [&](int l) {
+        active &= ~(1u << l);
+        job[l] = -1;
+        while (next < count) {
+            job[l] = next;
+            state[l] = roots[next * stride];
+            rng[l].reseed(seeds[next]);
+            moveCount[l] = 0;
+            next++;
+            if (state[l].gameOver) { finish(l); continue; }
+            loadSlots(l);
+            loadWonders(l);
+            active |= 1u << l;
+            return;
+        }
+    };
+
+    for (int l = 0; l < LANES; l++) start(l);
+    MCTSMove moves[MAX_ACTIONS];
+    while (active) {
+        for (uint32_t m = active; m; m &= m - 1) loadDynamic(countr_zero(m));
+        if (simd) computeSimd(active);
+        else computeScalar(active);
+
+        for (uint32_t m = active; m; m &= m - 1) {
+            int l = countr_zero(m);
+            GameState& s = state[l];
+            int n = listMoves(l, moves);
+            MCTSMove mv = Rollout::pickMove(policy, s, moves, n, rng[l]);
+            if (logs) logs[job[l]].push_back(mv);
+            s.executeAction({mv.type, mv.cardId, mv.wonderIdx});
+            s.advance();
+            moveCount[l]++;
+            if (s.gameOver) {
+                finish(l);
+                start(l);
+            } else if (s.age != slotAge[l]) {
+                loadSlots(l);
+            }
+        }
+    }
+}
+
+void BatchRollout::run(const GameState roots[], int count, const uint64_t seeds[], RolloutOutcome out[],
+                       vector<MCTSMove>* logs) {
+    runStrided(roots, 1, count, seeds, out, logs);
+}
+
+void BatchRollout::runFrom(const GameState& root, int count, uint64_t seed, RolloutOutcome out[]) {
+    Rng master(seed);
+    vector<uint64_t> seeds(count);
+    for (uint64_t& s : seeds) s = master();
+    runStrided(&root, 0, count, seeds.data(), out, nullptr);
+}
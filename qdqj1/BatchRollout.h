@@ -0,0 +1,117 @@
+/**
+ * @file BatchRollout.h
+ * @brief 多局同步推进的批量模拟 (rollout) 后端
+ * 作用：同时推进 LANES 局互相独立的模拟，每局占一个“通道”。
+ *      规则推进仍由各通道自己的 GameState 完成；每一步最耗时的部分
+ *      —— 为行动方计算版图上每张牌和每个奇迹的交易费用、判断买不买得起 ——
+ *      改为在按通道排列的结构 (SoA) 上对所有通道一起计算，
+ *      支持 AVX2 时每条指令处理 8 个通道，否则退回逐通道调用 CostKernel 的标量实现。
+ *      生成的行动列表与 MCTSStrategy::generateMoves 顺序一致，走子策略与
+ *      MCTSStrategy::rollout 相同，因此同一局面、同一随机种子下两者的结果完全相同。
+ */
+
+#ifndef BATCHROLLOUT_H
+#define BATCHROLLOUT_H
+
+#include "GameState.h"
+#include "MCTS.h"
+#include "Random.h"
+#include <cstdint>
+#include <vector>
+
+/**
+ * @struct RolloutOutcome
+ * @brief 一局模拟的结果
+ */
+struct RolloutOutcome {
+    uint8_t winner;         // 胜者 (0 / 1)
+    uint8_t victory;        // VictoryType
+    int16_t scores[2];      // 终局时双方的总分 (GameState::calculateScore)
+    uint16_t moves;         // 模拟中执行的行动数
+};
+
+class BatchRollout {
+public:
+    static const int LANES = 16;
+
+    /**
+     * @param policy 走子方式 (与 MCTSConfig::rollout 含义相同)
+     * @param simd   是否使用 AVX2 (CPU 不支持时自动退回标量实现)
+     */
+    explicit BatchRollout(RolloutPolicy policy = ROLLOUT_GREEDY, bool simd = true);
+
+    // 本机是否可以使用 AVX2 实现
+    static bool simdSupported();
+    bool usingSimd() const { return simd; }
+
+    /**
+     * @brief 从 roots[i] 各模拟一局到终局，共 count 局
+     * 第 i 局的走子随机源为 Rng(seeds[i])；局面中的随机源 (后续发牌、大图书馆) 原样使用，
+     * 需要隐藏信息时由调用方事先抽样 (见 MCTSStrategy::determinize)。
+     * 通道数少于 count 时，某个通道的对局一结束就接着开始下一局。
+     * @param logs 不为空时记录每局的行动序列 (logs 需有 count 个元素)
+     */
+    void run(const GameState roots[], int count, const uint64_t seeds[], RolloutOutcome out[],
+             std::vector<MCTSMove>* logs = nullptr);
+
+    /**
+     * @brief 从同一局面模拟 count 局 (第 i 局种子由 seed 与 i 派生)
+     */
+    void runFrom(const GameState& root, int count, uint64_t seed, RolloutOutcome out[]);
+
+private:
+    // 按通道排列的 32 位整数 (一条 AVX2 寄存器放 8 个通道)
+    struct alignas(32) Lanes {
+        int32_t v[LANES];
+    };
+
+    // 每步由 GameState 刷新的行动方数据
+    struct Dynamic {
+        Lanes coins;
+        Lanes production[5];
+        Lanes oppProduction[5];     // 对手产量 (单价 = 2 + 对手产量)
+        Lanes tradeFixed;           // 贸易固定价格位 (对应资源单价为 1)
+        Lanes chainIcons;
+        Lanes architecture;         // 行动方有建筑学时为 -1 (奇迹费用折扣 2 份)
+        uint32_t available[LANES];  // 可拿的版图位置
+    };
+
+    // 本时代版图上每个位置的卡牌费用；发新时代的牌时刷新
+    struct SlotCosts {
+        Lanes need[20][5];
+        Lanes coins[20];
+        Lanes chainCost[20];        // 免费连锁所需的符号，没有时为 32 (移位后恒为 0)
+    };
+
+    // 双方每个奇迹的费用；通道开始新的一局时刷新 (第 7 个奇迹建成后不再能建奇迹)
+    struct WonderCosts {
+        Lanes need[2][4][5];
+        Lanes coins[2][4];          // 直接付金币的奇迹 (此时不需要资源)
+    };
+
+    RolloutPolicy policy;
+    bool simd;
+    GameState state[LANES];
+    Rng rng[LANES];
+    int job[LANES];                 // 通道正在进行的是第几局，-1 表示空闲
+    int slotAge[LANES];             // slots 中该通道的数据属于哪个时代
+    uint16_t moveCount[LANES];
+    Dynamic dyn;
+    SlotCosts slots;
+    WonderCosts wonders;
+    Lanes mover;                    // 行动方 (选择奇迹费用用哪一方的)
+    uint32_t buildable[LANES];      // 输出：买得起 (或可免费连锁) 的位置
+    uint8_t wonderAffordable[LANES];// 输出：买得起的奇迹序号位
+
+    void loadSlots(int lane);
+    void loadWonders(int lane);
+    void loadDynamic(int lane);
+    void runStrided(const GameState* roots, size_t stride, int count, const uint64_t seeds[],
+                    RolloutOutcome out[], std::vector<MCTSMove>* logs);
+    void computeScalar(uint32_t activeLanes);
+    void computeSimd(uint32_t activeLanes);
+    // 按 generateMoves 的顺序列出通道的合法行动
+    int listMoves(int lane, MCTSMove out[]) const;
+};
+
+#endif
@@ -0,0 +1,105 @@
+/**
+ * @file BoardLayout.h
+ * @brief 三个时代的金字塔版图结构 (编译期常量表)
+ * 作用：每个位置的行列、初始朝向以及覆盖关系在编译期算好，
+ *      每个时代发牌时只需写入 20 个卡牌编号。
+ */
+
+#ifndef BOARDLAYOUT_H
+#define BOARDLAYOUT_H
+
+#include <cstdint>
+
+/**
+ * @struct SlotLayout
+ * @brief 单个版图位置的固定信息
+ */
+struct SlotLayout {
+    uint8_t row;
+    uint8_t col;
+    bool faceUp;        // 发牌时是否正面朝上
+    uint32_t coveredBy; // 压住该位置的牌 (第 i 位 = 位置 i)
+    uint32_t reveals;   // 被该位置压住的牌
+};
+
+/**
+ * @struct AgeLayout
+ * @brief 某个时代的完整版图结构
+ */
+struct AgeLayout {
+    SlotLayout slots[20];
+    uint32_t initialAvailable; // 开局即可拿的位置 (无人压住)
+};
+
+/**
+ * @brief 在编译期生成某个时代的版图结构
+ * 位置按行从上到下、每行从左到右编号，偶数行正面朝上。
+ */
+constexpr AgeLayout makeAgeLayout(int age) {
+    AgeLayout l{};
+    int rows[7] = {};
+    int rowCount = 0;
+    if (age == 1) { int r[] = {2, 3, 4, 5, 6}; for (int x : r) rows[rowCount++] = x; }
+    else if (age == 2) { int r[] = {6, 5, 4, 3, 2}; for (int x : r) rows[rowCount++] = x; }
+    else { int r[] = {2, 3, 4, 2, 4, 3, 2}; for (int x : r) rows[rowCount++] = x; }
+
+    int start[7] = {};
+    int id = 0;
+    for (int r = 0; r < rowCount; r++) {
+        start[r] = id;
+        for (int c = 0; c < rows[r]; c++) l.slots[id++] = {(uint8_t)r, (uint8_t)c, r % 2 == 0, 0, 0};
+    }
+    auto addCover = [&l](int me, int cover) {
+        l.slots[me].coveredBy |= 1u << cover;
+        l.slots[cover].reveals |= 1u << me;
+    };
+
+    if (age == 1) {
+        // 正金字塔：每张牌被下一行相邻两张压住
+        for (int r = 0; r < 4; r++) {
+            for (int i = 0; i < rows[r]; i++) {
+                addCover(start[r] + i, start[r + 1] + i);
+                addCover(start[r] + i, start[r + 1] + i + 1);
+            }
+        }
+    } else if (age == 2) {
+        // 倒金字塔：两端的牌只被一张压住
+        for (int r = 0; r < 4; r++) {
+            for (int i = 0; i < rows[r]; i++) {
+                if (i - 1 >= 0) addCover(start[r] + i, start[r + 1] + i - 1);
+                if (i < rows[r + 1]) addCover(start[r] + i, start[r + 1] + i);
+            }
+        }
+    } else {
+        // 异形结构：覆盖关系逐条列出
+        const int covers[][2] = {
+            {0, 2}, {0, 3}, {1, 3}, {1, 4},
+            {2, 5}, {2, 6}, {3, 6}, {3, 7}, {4, 7}, {4, 8},
+            {5, 9}, {6, 9}, {7, 10}, {8, 10},
+            {9, 11}, {9, 12}, {10, 13}, {10, 14},
+            {11, 15}, {12, 15}, {12, 16}, {13, 16}, {13, 17}, {14, 17},
+            {15, 18}, {16, 18}, {16, 19}, {17, 19},
+        };
+        for (auto& c : covers) addCover(c[0], c[1]);
+    }
+
+    for (int i = 0; i < 20; i++) {
+        if (l.slots[i].coveredBy == 0) l.initialAvailable |= 1u << i;
+    }
+    return l;
+}
+
+/// 按时代 (1~3) 索引的版图结构，下标 0 对应时代一
+inline constexpr AgeLayout AGE_LAYOUTS[3] = {
+    makeAgeLayout(1),
+    makeAgeLayout(2),
+    makeAgeLayout(3),
+};
+
+inline const AgeLayout& getAgeLayout(int age) { return AGE_LAYOUTS[age - 1]; }
+
+static_assert(AGE_LAYOUTS[0].initialAvailable == 0xFC000, "时代一最下面一行 (14~19) 开局可拿");
+static_assert(AGE_LAYOUTS[1].initialAvailable == 0xC0000, "时代二最下面一行 (18~19) 开局可拿");
+static_assert(AGE_LAYOUTS[2].initialAvailable == 0xC0000, "时代三最下面一行 (18~19) 开局可拿");
+
+#endif
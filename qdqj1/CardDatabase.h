@@ -2,15 +2,23 @@
 #define CARDDATABASE_H
 
 #include "Structs.h"
-#include <vector>
+#include "Random.h"
+#include <array>
+
+// 一个时代的牌库 (卡牌编号)，洗牌后取前 20 张上桌
+using AgeDeck = std::array<int, 23>;
 
 class CardDatabase {
 public:
-    // 根据时代获取原始卡牌列表
-    static std::vector<Card> loadCardsForAge(int age);
-    
-    // 获取所有奇迹
-    static std::vector<Wonder> loadWonders();
+    static const int CARD_COUNT = 73;   // 三个时代的卡牌总数 (含 7 张公会卡)
+    static const int WONDER_COUNT = 12; // 奇迹总数
+
+    // 根据时代获取卡牌编号列表 (第三时代的 3 张公会卡从 rng 中抽取)
+    static AgeDeck loadCardsForAge(int age, Rng& rng);
+
+    // 按编号查询卡牌 / 奇迹 (编号即 Card::id / Wonder::id)
+    static const Card& getCard(int id);
+    static const Wonder& getWonder(int id);
 };
 
 #endif
\ No newline at end of file
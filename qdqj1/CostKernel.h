@@ -0,0 +1,72 @@
+/**
+ * @file CostKernel.h
+ * @brief 无分配的资源费用计算核心
+ * 作用：在五种资源的定长数组上计算交易费用，不创建任何 vector、不排序。
+ *      Game 与搜索用的紧凑局面共用这一套计算，保证两边规则一致。
+ */
+
+#ifndef COSTKERNEL_H
+#define COSTKERNEL_H
+
+#include "Enums.h"
+#include <cstdint>
+
+/**
+ * @struct TradeContext
+ * @brief 某位买家在当前局面下的交易报价
+ * 每回合只需为行动方生成一次，之后对每张卡的费用计算都复用它。
+ */
+struct TradeContext {
+    uint8_t production[5];  // 买家自己的资源产量
+    uint8_t price[5];       // 每缺 1 份资源需支付的金币 (2 + 对手产量，或贸易卡固定的 1)
+};
+
+class CostKernel {
+public:
+    /**
+     * @brief 生成交易报价
+     * @param production    买家产量 (按 Resource 下标)
+     * @param oppProduction 对手产量
+     * @param tradeFixed    买家的贸易固定价格位掩码
+     */
+    static TradeContext makeContext(const uint8_t production[5], const uint8_t oppProduction[5], uint8_t tradeFixed) {
+        TradeContext ctx;
+        for (int r = 0; r < 5; r++) {
+            ctx.production[r] = production[r];
+            ctx.price[r] = ((tradeFixed >> r) & 1) ? 1 : 2 + oppProduction[r];
+        }
+        return ctx;
+    }
+
+    /**
+     * @brief 计算购买缺少资源的总金币
+     * 与原先“把每份缺少的资源单价放进数组、降序排序、跳过前 discount 个”的结果相同：
+     * 折扣 (最多 2 份) 总是抵掉单价最高的资源。
+     * @param need     所需资源 (按 Resource 下标)
+     * @param discount 免费抵扣的资源份数 (建筑学 / 砌体结构为 2)
+     */
+    static int tradeCost(const TradeContext& ctx, const uint8_t need[5], int discount) {
+        int missing[5];
+        int total = 0;
+        for (int r = 0; r < 5; r++) {
+            int m = need[r] - ctx.production[r];
+            missing[r] = m > 0 ? m : 0;
+            total += missing[r] * ctx.price[r];
+        }
+        // 每轮找出仍有缺口的最贵资源，抵掉尽可能多的份数；折扣最多 2 份，至多循环两次
+        while (discount > 0) {
+            int best = -1;
+            for (int r = 0; r < 5; r++) {
+                if (missing[r] > 0 && (best < 0 || ctx.price[r] > ctx.price[best])) best = r;
+            }
+            if (best < 0) break;
+            int k = missing[best] < discount ? missing[best] : discount;
+            total -= k * ctx.price[best];
+            missing[best] = 0;
+            discount -= k;
+        }
+        return total;
+    }
+};
+
+#endif
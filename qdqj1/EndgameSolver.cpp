@@ -0,0 +1,102 @@
+/**
+ * @file EndgameSolver.cpp
+ * @brief 残局求解器的实现
+ */
+
+#include "EndgameSolver.h"
+#include "AlphaBeta.h"
+#include "GameView.h"
+#include <bit>
+
+using namespace std;
+
+static const int SOLVED_DEPTH = 64;     // 置换表中求解器条目的深度：结果都是精确搜到终局的
+
+EndgameSolver::EndgameSolver(shared_ptr<TranspositionTable> table, size_t tableMegabytes, bool hugePages) : table(table) {
+    if (!this->table) this->table = make_shared<TranspositionTable>(tableMegabytes, hugePages);
+}
+
+bool EndgameSolver::solvable(const GameState& s) {
+    uint32_t hidden = ~(s.taken | s.faceUp) & ((1u << 20) - 1);
+    return s.age == 3 && !s.gameOver && hidden == 0;
+}
+
+int EndgameSolver::terminalValue(const GameState& s, int p) {
+    int margin = 0;
+    if (s.victory == V_CIVILIAN) margin = s.calculateScore(p) - s.calculateScore(1 - p);
+    return (s.winner == p ? WIN_SCORE : -WIN_SCORE) + margin;
+}
+
+int EndgameSolver::search(GameState& s, int alpha, int beta, MCTSMove* best) {
+    nodeCount++;
+    int alphaOrig = alpha;
+    uint8_t ttMove = NO_ACTION_CODE;
+    int ttScore;
+    // 根节点需要具体的行动：要求比求解器条目更深，从不直接返回
+    if (AlphaBeta::probe(*table, s.hash, best ? SOLVED_DEPTH + 1 : SOLVED_DEPTH, alpha, beta, ttMove, ttScore)) return ttScore;
+
+    MCTSMove moves[MAX_ACTIONS];
+    int n = MCTSStrategy::generateMoves(s, moves);
+    AlphaBeta::orderMoves(s, moves, n, ttMove, false);
+
+    int bestValue = -AlphaBeta::INF;
+    uint8_t bestMove = NO_ACTION_CODE;
+    for (int i = 0; i < n; i++) {
+        const MCTSMove& m = moves[i];
+        int mover = s.activePlayer;
+        s.applyMove({m.type, m.cardId, m.wonderIdx}, -1, undo);
+        int v;
+        if (s.gameOver) v = terminalValue(s, mover);
+        else if (s.activePlayer == mover) v = search(s, alpha, beta, nullptr);     // 额外回合
+        else v = -search(s, -beta, -alpha, nullptr);
+        s.undoMove(undo);
+        if (v > bestValue) {
+            bestValue = v;
+            bestMove = encodeAction({m.type, m.cardId, m.wonderIdx});
+            if (best) *best = m;
+        }
+        alpha = max(alpha, v);
+        if (alpha >= beta) break;
+    }
+    AlphaBeta::store(*table, s.hash, bestValue, alphaOrig, beta, SOLVED_DEPTH, bestMove);
+    return bestValue;
+}
+
+int EndgameSolver::solve(const GameState& root, MCTSMove& best, uint64_t seed) {
+    GameState s = root;
+    s.rng.reseed(seed);
+    undo.clear();
+    nodeCount = 0;
+    table->newSearch();
+    return search(s, -AlphaBeta::INF, AlphaBeta::INF, &best);
+}
+
+// --- EndgameStrategy ---
+
+EndgameStrategy::EndgameStrategy(unique_ptr<PlayerStrategy> inner, uint64_t seed)
+    : inner(std::move(inner)), rng(seed) {}
+
+Action EndgameStrategy::makeDecision(const GameView& view) {
+    GameState s = view.publicSnapshot();
+    solving = EndgameSolver::solvable(s);
+    if (!solving) return inner->makeDecision(view);
+    MCTSMove best;
+    solver.solve(s, best, rng());
+    return {best.type, best.cardId, best.wonderIdx};
+}
+
+int EndgameStrategy::chooseWonder(const vector<int>& options, const GameView& view) {
+    return inner->chooseWonder(options, view);
+}
+
+int EndgameStrategy::chooseCardFromDiscard(const vector<int>& pile, const GameView& view) {
+    return solving ? SearchStrategy::chooseCardFromDiscard(pile, view) : inner->chooseCardFromDiscard(pile, view);
+}
+
+int EndgameStrategy::chooseCardToDestroy(const vector<int>& targets, const GameView& view) {
+    return solving ? SearchStrategy::chooseCardToDestroy(targets, view) : inner->chooseCardToDestroy(targets, view);
+}
+
+int EndgameStrategy::chooseToken(const vector<ProgressToken>& options, const GameView& view) {
+    return solving ? SearchStrategy::chooseToken(options, view) : inner->chooseToken(options, view);
+}
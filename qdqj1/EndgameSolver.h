@@ -0,0 +1,86 @@
+/**
+ * @file EndgameSolver.h
+ * @brief 第三时代残局的精确求解
+ * 作用：第三时代剩下的牌全部正面朝上后，之后的对局只取决于双方的选择
+ *      (大图书馆的抽取除外)。求解器在 GameState 上用 alpha-beta + 置换表
+ *      搜到终局，按真实的终局计分 (GameState::calculateScore，含公会与
+ *      农业 / 哲学 / 数学科技币) 求出精确结果和最佳行动。
+ *      EndgameStrategy 可以包在任意策略外面，在最后几回合切换到求解器。
+ */
+
+#ifndef ENDGAMESOLVER_H
+#define ENDGAMESOLVER_H
+
+#include "Strategy.h"
+#include "GameState.h"
+#include "MCTS.h"
+#include "Random.h"
+#include "TranspositionTable.h"
+#include <cstdint>
+#include <memory>
+
+/**
+ * @class EndgameSolver
+ * @brief 残局求解器
+ * 分值从行动方视角计算：胜为 WIN_SCORE + 分差，负为 -WIN_SCORE + 分差
+ * (压制胜利的分差按 0 计)，因此先保证胜负，再在同样的胜负里追求分差。
+ */
+class EndgameSolver {
+public:
+    static const int WIN_SCORE = 10000;
+
+    /**
+     * @param table 置换表；为空时自建一张 tableMegabytes 大小的表 (hugePages 见 TranspositionTable)
+     */
+    explicit EndgameSolver(std::shared_ptr<TranspositionTable> table = nullptr, size_t tableMegabytes = 16, bool hugePages = false);
+
+    /**
+     * @brief 是否可以精确求解
+     * 第三时代、对局未结束，且未拿走的位置全部正面朝上 (没有未知的牌)。
+     */
+    static bool solvable(const GameState& s);
+
+    /**
+     * @brief 求解 s 并给出行动方的最佳行动
+     * s 的随机源在求解前被换成 seed (大图书馆的抽取对双方都是未知的)。
+     * @return 行动方视角的精确分值
+     */
+    int solve(const GameState& s, MCTSMove& best, uint64_t seed = 1);
+
+    // 上一次 solve 访问的节点数
+    long nodes() const { return nodeCount; }
+
+private:
+    std::shared_ptr<TranspositionTable> table;
+    UndoStack undo;
+    long nodeCount = 0;
+
+    int search(GameState& s, int alpha, int beta, MCTSMove* best);
+    static int terminalValue(const GameState& s, int p);
+};
+
+/**
+ * @class EndgameStrategy
+ * @brief 残局切换：局面可解时由求解器决策，否则交给内部策略
+ * 求解器模拟陵墓 / 宙斯神像 / 竞技场时使用 GameState 的默认选择，
+ * 因此由求解器决策之后的附带选择使用 SearchStrategy 的钩子；
+ * 其余时候 (包括开局的奇迹轮抽) 全部转交内部策略。
+ */
+class EndgameStrategy : public SearchStrategy {
+public:
+    explicit EndgameStrategy(std::unique_ptr<PlayerStrategy> inner, uint64_t seed = 1);
+
+    Action makeDecision(const GameView& view) override;
+    int chooseWonder(const std::vector<int>& options, const GameView& view) override;
+    int chooseCardFromDiscard(const std::vector<int>& pile, const GameView& view) override;
+    int chooseCardToDestroy(const std::vector<int>& targets, const GameView& view) override;
+    int chooseToken(const std::vector<ProgressToken>& options, const GameView& view) override;
+
+private:
+    std::unique_ptr<PlayerStrategy> inner;
+    EndgameSolver solver;
+    Rng rng;
+    bool solving = false;   // 上一次行动是否由求解器决定
+};
+
+#endif
@@ -5,6 +5,17 @@
 
 #include "Enums.h"
 
+/**
+ * @brief 实现 getResourceName 函数
+ */
+std::string getResourceName(Resource r) {
+    switch(r) {
+    case WOOD: return "木"; case CLAY: return "土"; case STONE: return "石";
+    case GLASS: return "玻"; case PAPYRUS: return "纸";
+    default: return "";
+    }
+}
+
 /**
  * @brief 实现 getChainName 函数
  * 通过 switch-case 将枚举值转换为汉化的字符串
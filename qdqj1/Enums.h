@@ -102,8 +102,47 @@ enum ProgressToken {
     P_URBANISM      // 城市规划
 };
 
+/**
+ * @enum VictoryType
+ * @brief 胜利方式枚举
+ * 用于记录对局以何种方式结束 (无界面批量模拟时统计使用)。
+ */
+enum VictoryType {
+    V_NONE,         // 尚未分出胜负
+    V_MILITARY,     // 军事压制
+    V_SCIENCE,      // 科技压制
+    V_CIVILIAN      // 第三时代结束后按总分结算
+};
+
+/**
+ * @enum WonderId
+ * @brief 奇迹编号枚举
+ * 与 CardDatabase 奇迹总表的下标一一对应，用于按编号判断奇迹的特殊效果。
+ */
+enum WonderId {
+    W_APPIAN_WAY,       // 亚壁古道
+    W_CIRCUS_MAXIMUS,   // 马克西姆斯竞技场
+    W_COLOSSUS,         // 罗德岛太阳神铜像
+    W_GREAT_LIBRARY,    // 大图书馆
+    W_GREAT_LIGHTHOUSE, // 大灯塔
+    W_HANGING_GARDENS,  // 空中花园
+    W_MAUSOLEUM,        // 摩索拉斯陵墓
+    W_PIRAEUS,          // 比雷埃夫斯港
+    W_PYRAMIDS,         // 金字塔
+    W_SPHINX,           // 斯芬克斯
+    W_STATUE_OF_ZEUS,   // 宙斯神像
+    W_TEMPLE_OF_ARTEMIS // 阿尔忒弥斯神庙
+};
+
 // --- 辅助函数声明 ---
 
+/**
+ * @brief 获取资源的中文简称
+ * @param r 资源枚举值
+ * @return 对应的单字简称 (木/土/石/玻/纸)
+ */
+std::string getResourceName(Resource r);
+
 /**
  * @brief 获取连锁符号的中文名称
  * @param c 连锁符号枚举值
@@ -0,0 +1,211 @@
+/**
+ * @file Expectiminimax.cpp
+ * @brief 带机会节点的 alpha-beta 搜索策略的实现
+ */
+
+#include "Expectiminimax.h"
+#include "AlphaBeta.h"
+#include "GameView.h"
+#include "CardDatabase.h"
+#include "BoardLayout.h"
+#include <algorithm>
+#include <bit>
+#include <cstdlib>
+
+using namespace std;
+
+ExpectiminimaxStrategy::ExpectiminimaxStrategy(ExpectiminimaxConfig config)
+    : config(config), table(config.table), rng(config.seed) {
+    if (!table) table = make_shared<TranspositionTable>(config.tableMegabytes, config.hugePages);
+}
+
+int ExpectiminimaxStrategy::evaluate(const GameState& s, int p) {
+    int o = 1 - p;
+    int e = s.calculateScore(p) - s.calculateScore(o);
+    int track = (p == 0) ? s.militaryTrack : -s.militaryTrack;
+    e += track * abs(track) / 2;
+    int sp = s.countScienceDistinct(p), so = s.countScienceDistinct(o);
+    e += (sp * sp - so * so) / 2;
+    for (int r = WOOD; r <= PAPYRUS; r++) e += (4 - s.age) * (s.players[p].production[r] - s.players[o].production[r]);
+    if (s.age == 3) {
+        for (uint32_t m = s.faceUp & ~s.taken & ((1u << 20) - 1); m; m &= m - 1) {
+            const Card& c = CardDatabase::getCard(s.slotCard[countr_zero(m)]);
+            if (c.type == GUILD) e += (s.calculateGuildPoints(p, c.guildType) - s.calculateGuildPoints(o, c.guildType)) / 2;
+        }
+    }
+    return e;
+}
+
+uint32_t ExpectiminimaxStrategy::hiddenReveals(const GameState& s, int slot) {
+    const AgeLayout& layout = getAgeLayout(s.age);
+    uint32_t takenAfter = s.taken | (1u << slot);
+    uint32_t out = 0;
+    for (uint32_t m = layout.slots[slot].reveals & ~takenAfter & ~s.faceUp; m; m &= m - 1) {
+        int c = countr_zero(m);
+        if ((layout.slots[c].coveredBy & ~takenAfter) == 0) out |= 1u << c;
+    }
+    return out;
+}
+
+int ExpectiminimaxStrategy::searchChild(GameState& s, MCTSMove m, int depth, int alpha, int beta) {
+    int mover = s.activePlayer;
+    int ageBefore = s.age;
+    s.applyMove({m.type, m.cardId, m.wonderIdx}, -1, undo);
+    int v;
+    if (s.gameOver) v = (s.winner == mover) ? WIN_SCORE : -WIN_SCORE;
+    else if (s.age != ageBefore) v = evaluate(s, mover);     // 新时代的牌未知，搜索到此为止
+    else if (s.activePlayer == mover) v = search(s, depth - 1, alpha, beta);  // 额外回合
+    else v = -search(s, depth - 1, -beta, -alpha);
+    s.undoMove(undo);
+    return v;
+}
+
+/**
+ * @brief 机会节点：对翻开的背面牌可能是哪张牌取平均
+ * 候选为牌堆中可能还有的牌：本时代尚未出现的非公会卡都在牌堆里；没见过的公会卡中只有
+ * deckGuilds 张在牌堆里 (已见满 3 张时不再是候选)。因此每张没见过的公会卡翻出的概率是
+ * 一张非公会卡的 deckGuilds / 没见过的公会卡数 倍。
+ * 只翻一张且候选不多时逐一展开并按概率加权，否则按 MCTSStrategy::determinize 的方式
+ * (先定下牌堆里是哪几张公会卡，再从牌堆中均匀抽取) 抽样 chanceSamples 种结果。
+ * 机会节点下的子局面使用完整窗口搜索，保证平均值是精确的期望。
+ */
+int ExpectiminimaxStrategy::searchMove(GameState& s, MCTSMove m, int depth, int alpha, int beta) {
+    uint32_t reveals = hiddenReveals(s, m.cardId);
+    if (!reveals) return searchChild(s, m, depth, alpha, beta);
+
+    int pool[32], guildPool[8];
+    int n = 0, guilds = 0;
+    for (int w = 0; w < 2; w++) {
+        for (uint64_t bits = unseen[w]; bits; bits &= bits - 1) {
+            int id = w * 64 + countr_zero(bits);
+            if (CardDatabase::getCard(id).type == GUILD) guildPool[guilds++] = id;
+            else pool[n++] = id;
+        }
+    }
+    if (deckGuilds == 0) guilds = 0;
+    int k = popcount(reveals);
+    bool enumerate = (k == 1 && n + guilds <= config.chanceSamples);
+    int outcomes = enumerate ? n + guilds : config.chanceSamples;
+
+    long sum = 0, totalWeight = 0;
+    for (int o = 0; o < outcomes; o++) {
+        int picked[2];
+        long weight = 1;
+        if (enumerate) {
+            picked[0] = o < n ? pool[o] : guildPool[o - n];
+            weight = o < n ? max(guilds, 1) : deckGuilds;
+        } else {
+            int deck[32];
+            int size = n;
+            copy(pool, pool + n, deck);
+            for (int g = 0; g < deckGuilds && g < guilds; g++) {
+                swap(guildPool[g], guildPool[g + rng.below(guilds - g)]);
+                deck[size++] = guildPool[g];
+            }
+            // 抽 k 张互不相同的牌 (部分 Fisher-Yates)
+            for (int i = 0; i < k; i++) {
+                swap(deck[i], deck[i + rng.below(size - i)]);
+                picked[i] = deck[i];
+            }
+        }
+        int i = 0, guildsPicked = 0;
+        for (uint32_t bits = reveals; bits; bits &= bits - 1, i++) {
+            s.slotCard[countr_zero(bits)] = picked[i];
+            unseen[picked[i] >> 6] &= ~(1ull << (picked[i] & 63));
+            guildsPicked += CardDatabase::getCard(picked[i]).type == GUILD;
+        }
+        deckGuilds -= guildsPicked;
+        sum += weight * searchChild(s, m, depth, -AlphaBeta::INF, AlphaBeta::INF);
+        totalWeight += weight;
+        deckGuilds += guildsPicked;
+        for (int t = 0; t < k; t++) unseen[picked[t] >> 6] |= 1ull << (picked[t] & 63);
+        if (aborted) return 0;
+    }
+    return (int)(sum / totalWeight);
+}
+
+int ExpectiminimaxStrategy::search(GameState& s, int depth, int alpha, int beta) {
+    if ((++nodes & 1023) == 0 && chrono::steady_clock::now() >= deadline) aborted = true;
+    if (aborted) return 0;
+    if (depth <= 0) return evaluate(s, s.activePlayer);
+
+    int alphaOrig = alpha;
+    uint8_t ttMove = NO_ACTION_CODE;
+    int ttScore;
+    if (AlphaBeta::probe(*table, s.hash, depth, alpha, beta, ttMove, ttScore)) return ttScore;
+
+    MCTSMove moves[MAX_ACTIONS];
+    int n = MCTSStrategy::generateMoves(s, moves);
+    if (n == 0) return evaluate(s, s.activePlayer);
+    AlphaBeta::orderMoves(s, moves, n, ttMove, true);
+
+    int best = -AlphaBeta::INF;
+    uint8_t bestMove = NO_ACTION_CODE;
+    for (int i = 0; i < n; i++) {
+        int v = searchMove(s, moves[i], depth, alpha, beta);
+        if (aborted) return 0;
+        if (v > best) {
+            best = v;
+            bestMove = encodeAction({moves[i].type, moves[i].cardId, moves[i].wonderIdx});
+        }
+        alpha = max(alpha, v);
+        if (alpha >= beta) break;
+    }
+    AlphaBeta::store(*table, s.hash, best, alphaOrig, beta, depth, bestMove);
+    return best;
+}
+
+Action ExpectiminimaxStrategy::makeDecision(const GameView& view) {
+    GameState s = view.publicSnapshot();
+    MCTSMove moves[MAX_ACTIONS];
+    int n = MCTSStrategy::generateMoves(s, moves);
+    if (n == 0) {
+        uint32_t avail = view.availableMask();
+        return {2, avail ? countr_zero(avail) : 0, -1};
+    }
+    if (n == 1) return {moves[0].type, moves[0].cardId, moves[0].wonderIdx};
+
+    // 抹去背面朝上的牌，记录本时代尚未出现的牌；随机源换新 (大图书馆的抽取同样未知)
+    uint32_t hidden = ~(s.taken | s.faceUp) & ((1u << 20) - 1);
+    uint64_t seen[2] = {};
+    int seenGuilds = 0;
+    for (int i = 0; i < 20; i++) {
+        if ((hidden >> i) & 1) s.slotCard[i] = 0;
+        else {
+            seen[s.slotCard[i] >> 6] |= 1ull << (s.slotCard[i] & 63);
+            if (CardDatabase::getCard(s.slotCard[i]).type == GUILD) seenGuilds++;
+        }
+    }
+    deckGuilds = s.age == 3 ? max(3 - seenGuilds, 0) : 0;
+    unseen[0] = unseen[1] = 0;
+    for (int id = 0; id < CardDatabase::CARD_COUNT; id++) {
+        if (CardDatabase::getCard(id).age == s.age && !((seen[id >> 6] >> (id & 63)) & 1)) {
+            unseen[id >> 6] |= 1ull << (id & 63);
+        }
+    }
+    s.rng.reseed(rng());
+
+    table->newSearch();
+    undo.clear();
+    nodes = 0;
+    aborted = false;
+    deadline = chrono::steady_clock::now() + chrono::milliseconds(config.timeBudgetMs);
+    AlphaBeta::orderMoves(s, moves, n, NO_ACTION_CODE, true);
+
+    // 迭代加深：每完成一层就把该层的最佳行动移到最前，超时则采用上一层的结果
+    MCTSMove best = moves[0];
+    for (int depth = 1; depth <= config.maxDepth; depth++) {
+        int alpha = -AlphaBeta::INF;
+        int iterBest = 0;
+        for (int i = 0; i < n; i++) {
+            int v = searchMove(s, moves[i], depth, alpha, AlphaBeta::INF);
+            if (aborted) break;
+            if (v > alpha) { alpha = v; iterBest = i; }
+        }
+        if (aborted) break;
+        best = moves[iterBest];
+        rotate(moves, moves + iterBest, moves + iterBest + 1);
+        if (alpha >= WIN_SCORE) break;
+    }
+    return {best.type, best.cardId, best.wonderIdx};
+}
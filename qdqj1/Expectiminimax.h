@@ -0,0 +1,75 @@
+/**
+ * @file Expectiminimax.h
+ * @brief 带机会节点的 alpha-beta 搜索策略
+ * 作用：除了翻开背面朝上的牌和大图书馆抽科技币之外，对局是确定的。
+ *      本策略在 GameState 上用 applyMove / undoMove 深度优先搜索：
+ *      玩家行动处做 alpha-beta，拿牌会翻开背面牌时在机会节点上
+ *      对“本时代牌堆中尚未出现的牌”按各自的概率取平均 (第三时代 7 张公会卡中只有 3 张在牌堆里)。
+ *      迭代加深，受时间预算限制，
+ *      局面结果存入 (可共享的) 置换表。
+ *      背面朝上的牌在搜索开始前即被抹去，搜索不会读取它们的真实卡牌。
+ */
+
+#ifndef EXPECTIMINIMAX_H
+#define EXPECTIMINIMAX_H
+
+#include "Strategy.h"
+#include "GameState.h"
+#include "MCTS.h"
+#include "Random.h"
+#include "TranspositionTable.h"
+#include <chrono>
+#include <cstdint>
+#include <memory>
+
+/**
+ * @struct ExpectiminimaxConfig
+ * @brief 搜索参数
+ */
+struct ExpectiminimaxConfig {
+    int timeBudgetMs = 200;         // 每次决策的时间预算 (毫秒)
+    int maxDepth = 16;              // 迭代加深的最大深度 (玩家行动层数)
+    int chanceSamples = 4;          // 每个机会节点最多展开的翻牌结果数 (候选更多时随机抽样)
+    size_t tableMegabytes = 16;     // 未提供共享置换表时自建表的大小
+    bool hugePages = false;         // 自建表是否尝试使用大页 (见 TranspositionTable)
+    std::shared_ptr<TranspositionTable> table;  // 可由多个策略 / 线程共享
+    uint64_t seed = 1;              // 机会节点抽样与大图书馆使用的随机种子
+};
+
+class ExpectiminimaxStrategy : public SearchStrategy {
+public:
+    explicit ExpectiminimaxStrategy(ExpectiminimaxConfig config = {});
+
+    Action makeDecision(const GameView& view) override;
+
+    /**
+     * @brief 静态估值 (玩家 p 的视角)
+     * 当前总分之差 (胜利点、金币/3、军事分、公会、科技币加分)，
+     * 加上随军事条位置平方增长的压制威胁、随科技种类数平方增长的科技威胁，
+     * 资源产量之差 (越早的时代权重越高，产量能降低之后的建造费用)，
+     * 以及公会潜力：版图上正面朝上、尚未被拿走的公会卡，双方此刻建成它的得分之差的一半。
+     */
+    static int evaluate(const GameState& s, int p);
+
+    static const int WIN_SCORE = 30000;
+
+private:
+    ExpectiminimaxConfig config;
+    std::shared_ptr<TranspositionTable> table;
+    Rng rng;
+    UndoStack undo;
+    uint64_t unseen[2];     // 本时代尚未出现的牌 (按卡牌编号的位集合)，随翻牌增减
+    int deckGuilds = 0;     // 牌堆中尚未出现的公会卡张数 (第三时代为 3 减去已见的公会卡)，随翻牌增减
+    long nodes = 0;
+    bool aborted = false;
+    std::chrono::steady_clock::time_point deadline;
+
+    int search(GameState& s, int depth, int alpha, int beta);
+    // 走一步并返回该步之后的局面对行动方的价值；会翻开背面牌时在这里展开机会节点
+    int searchMove(GameState& s, MCTSMove m, int depth, int alpha, int beta);
+    int searchChild(GameState& s, MCTSMove m, int depth, int alpha, int beta);
+    // 拿走 slot 后会翻开的背面牌位置
+    static uint32_t hiddenReveals(const GameState& s, int slot);
+};
+
+#endif
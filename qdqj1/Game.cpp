@@ -4,20 +4,23 @@
  */
 
 #include "Game.h"
+#include "GameView.h"
 #include "Strategy.h"
 #include "CardDatabase.h"
 #include <iostream>
 #include <algorithm>
-#include <random>
-#include <chrono>
+#include <bit>
 #include <cmath>
+#include <cstring>
 
 using namespace std;
 
 Game::Game(string p1Name, unique_ptr<PlayerStrategy> s1,
-           string p2Name, unique_ptr<PlayerStrategy> s2)
+           string p2Name, unique_ptr<PlayerStrategy> s2,
+           uint64_t seed, bool headless)
     : p1(p1Name), strategyP1(std::move(s1)),
-      p2(p2Name), strategyP2(std::move(s2))
+      p2(p2Name), strategyP2(std::move(s2)),
+      rng(seed), headless(headless)
 {
     initTokens();
     dealWonders();
@@ -26,8 +29,7 @@ Game::Game(string p1Name, unique_ptr<PlayerStrategy> s1,
 
 void Game::initTokens() {
     vector<ProgressToken> all = {P_AGRICULTURE, P_ARCHITECTURE, P_ECONOMY, P_LAW, P_MASONRY, P_MATHEMATICS, P_PHILOSOPHY, P_STRATEGY, P_THEOLOGY, P_URBANISM};
-    unsigned seed = chrono::system_clock::now().time_since_epoch().count();
-    shuffle(all.begin(), all.end(), default_random_engine(seed));
+    rng.shuffle(all.begin(), all.end());
 
     availableTokens.clear();
     boxTokens.clear();
@@ -42,153 +44,94 @@ void Game::initTokens() {
     }
 }
 
-vector<Card> Game::getDeck(int age) {
-    vector<Card> deck = CardDatabase::loadCardsForAge(age);
-    unsigned seed = chrono::system_clock::now().time_since_epoch().count();
-    shuffle(deck.begin(), deck.end(), default_random_engine(seed));
-    deck.resize(20);
-    return deck;
+array<int, 20> Game::getDeck(int age) {
+    AgeDeck deck = CardDatabase::loadCardsForAge(age, rng);
+    rng.shuffle(deck.begin(), deck.end());
+    array<int, 20> dealt;
+    copy(deck.begin(), deck.begin() + 20, dealt.begin());
+    return dealt;
 }
 
 void Game::setupAge(int age) {
-    board.clear();
-    vector<Card> deck = getDeck(age);
-    int currentId = 0;
-    if (age == 1) {
-        int rows[] = {2,3,4,5,6};
-        vector<vector<int>> rowIds(5);
-        for(int r=0; r<5; r++){
-            for(int c=0; c<rows[r]; c++){
-                BoardSlot s; s.id = currentId; s.card = deck[currentId]; s.row = r; s.col = c;
-                s.faceUp = (r%2 == 0);
-                board.push_back(s); rowIds[r].push_back(currentId++);
-            }
-        }
-        for(int r=0; r<4; r++){
-            for(int i=0; i<rowIds[r].size(); i++){
-                board[rowIds[r][i]].coveredBy.push_back(rowIds[r+1][i]);
-                board[rowIds[r][i]].coveredBy.push_back(rowIds[r+1][i+1]);
-            }
-        }
-    } else if (age == 2) {
-        int rows[] = {6,5,4,3,2};
-        vector<vector<int>> rowIds(5);
-        for(int r=0; r<5; r++){
-            for(int c=0; c<rows[r]; c++){
-                BoardSlot s; s.id = currentId; s.card = deck[currentId]; s.row = r; s.col = c;
-                s.faceUp = (r%2 == 0);
-                board.push_back(s); rowIds[r].push_back(currentId++);
-            }
-        }
-        for(int r=0; r<4; r++){
-            for(int i=0; i<rowIds[r].size(); i++){
-                if(i-1 >= 0) board[rowIds[r][i]].coveredBy.push_back(rowIds[r+1][i-1]);
-                if(i < rowIds[r+1].size()) board[rowIds[r][i]].coveredBy.push_back(rowIds[r+1][i]);
-            }
-        }
-    } else {
-        int rows[] = {2, 3, 4, 2, 4, 3, 2};
-        for(int r=0; r<7; r++){
-            for(int c=0; c<rows[r]; c++){
-                BoardSlot s; s.id = currentId; s.card = deck[currentId]; s.row = r; s.col = c;
-                s.faceUp = (r % 2 == 0);
-                board.push_back(s);
-                currentId++;
-            }
-        }
-        auto addCover = [&](int me, int cover) { board[me].coveredBy.push_back(cover); };
-        addCover(0, 2); addCover(0, 3); addCover(1, 3); addCover(1, 4);
-        addCover(2, 5); addCover(2, 6); addCover(3, 6); addCover(3, 7); addCover(4, 7); addCover(4, 8);
-        addCover(5, 9); addCover(6, 9); addCover(7, 10); addCover(8, 10);
-        addCover(9, 11); addCover(9, 12); addCover(10, 13); addCover(10, 14);
-        addCover(11, 15); addCover(12, 15); addCover(12, 16); addCover(13, 16); addCover(13, 17); addCover(14, 17);
-        addCover(15, 18); addCover(16, 18); addCover(16, 19); addCover(17, 19);
-    }
+    layoutBoard(age, getDeck(age));
+}
+
+/**
+ * @brief 按时代的金字塔结构把 20 张牌摆上版图
+ */
+void Game::layoutBoard(int age, const array<int, 20>& deck) {
+    layout = &getAgeLayout(age);
+    for (int i = 0; i < 20; i++) {
+        const SlotLayout& sl = layout->slots[i];
+        board[i] = {i, deck[i], sl.faceUp, false, sl.row, sl.col};
+    }
+    takenMask = 0;
+    availableMask = layout->initialAvailable;
+    remainingCards = 20;
 }
-void performPick(Player& p, PlayerStrategy* strategy, std::vector<Wonder>& pool, Game& game) {
+void performPick(Player& p, int viewer, PlayerStrategy* strategy, std::vector<int>& pool, Game& game, bool headless) {
     if (pool.empty()) return;
     int choiceIdx = 0;
     if (pool.size() > 1) {
-        choiceIdx = strategy->chooseWonder(pool, game, p);
+        choiceIdx = strategy->chooseWonder(pool, GameView(game, viewer));
     } else {
-        std::cout << ">>> " << p.name << " 自动获得最后一张奇迹: " << pool[0].name << "\n";
+        if (!headless) std::cout << ">>> " << p.name << " 自动获得最后一张奇迹: " << CardDatabase::getWonder(pool[0]).name << "\n";
     }
-    p.wonders.push_back(pool[choiceIdx]);
+    p.wonders.push_back({pool[choiceIdx], false});
     pool.erase(pool.begin() + choiceIdx);
 }
 void Game::dealWonders() {
-    std::vector<Wonder> allWonders = CardDatabase::loadWonders();
-    unsigned seed = std::chrono::system_clock::now().time_since_epoch().count();
-    std::shuffle(allWonders.begin(), allWonders.end(), std::default_random_engine(seed));
-    std::vector<Wonder> round1Wonders(allWonders.begin(), allWonders.begin() + 4);
-    std::vector<Wonder> round2Wonders(allWonders.begin() + 4, allWonders.begin() + 8);
-    performPick(p1, strategyP1.get(), round1Wonders, *this);
-    performPick(p2, strategyP2.get(), round1Wonders, *this);
-    performPick(p2, strategyP2.get(), round1Wonders, *this);
-    performPick(p1, strategyP1.get(), round1Wonders, *this);
-    performPick(p2, strategyP2.get(), round2Wonders, *this);
-    performPick(p1, strategyP1.get(), round2Wonders, *this);
-    performPick(p1, strategyP1.get(), round2Wonders, *this);
-    performPick(p2, strategyP2.get(), round2Wonders, *this);
+    int allWonders[CardDatabase::WONDER_COUNT];
+    for (int i = 0; i < CardDatabase::WONDER_COUNT; i++) allWonders[i] = i;
+    rng.shuffle(allWonders, allWonders + CardDatabase::WONDER_COUNT);
+    std::vector<int> round1Wonders(allWonders, allWonders + 4);
+    std::vector<int> round2Wonders(allWonders + 4, allWonders + 8);
+    performPick(p1, 0, strategyP1.get(), round1Wonders, *this, headless);
+    performPick(p2, 1, strategyP2.get(), round1Wonders, *this, headless);
+    performPick(p2, 1, strategyP2.get(), round1Wonders, *this, headless);
+    performPick(p1, 0, strategyP1.get(), round1Wonders, *this, headless);
+    performPick(p2, 1, strategyP2.get(), round2Wonders, *this, headless);
+    performPick(p1, 0, strategyP1.get(), round2Wonders, *this, headless);
+    performPick(p1, 0, strategyP1.get(), round2Wonders, *this, headless);
+    performPick(p2, 1, strategyP2.get(), round2Wonders, *this, headless);
 }
 bool Game::isAvailable(int id) {
-    if (board[id].taken) return false;
-    for (int coverId : board[id].coveredBy) {
-        if (!board[coverId].taken) return false;
-    }
-    return true;
+    return (availableMask >> id) & 1;
 }
 std::vector<int> Game::getAvailableCards() {
     std::vector<int> avail;
-    for(auto& slot : board) if(isAvailable(slot.id)) avail.push_back(slot.id);
+    for(uint32_t m = availableMask; m; m &= m - 1) avail.push_back(countr_zero(m));
     return avail;
 }
-Card& Game::getCard(int id) { return board[id].card; }
-int Game::calculateResourceCost(Player& buyer, Player& opponent, const Cost& cost, CardType type, bool isWonder) {
+const Card& Game::getCard(int id) { return CardDatabase::getCard(board[id].cardId); }
+int Game::calculateResourceCost(const Player& buyer, const Player& opponent, const Cost& cost, CardType type, bool isWonder) {
     if (cost.coins > 0) return cost.coins;
     int discount = 0;
     if (isWonder && buyer.hasToken(P_ARCHITECTURE)) discount = 2;
     if (!isWonder && type == CIVILIAN && buyer.hasToken(P_MASONRY)) discount = 2;
-    int totalGoldNeeded = cost.coins;
-    vector<int> missingCosts;
-    for (auto const& [res, needed] : cost.resources) {
-        int produced = buyer.production[res];
-        if (produced < needed) {
-            int missing = needed - produced;
-            int oppProd = opponent.production[res];
-            int pricePerUnit = 2 + oppProd;
-            if (buyer.tradeFixed.count(res) && buyer.tradeFixed.at(res)) pricePerUnit = 1;
-            for(int k=0; k<missing; k++) missingCosts.push_back(pricePerUnit);
-        }
-    }
-    sort(missingCosts.rbegin(), missingCosts.rend());
-    for(int i = 0; i < missingCosts.size(); i++) {
-        if (i < discount) continue;
-        totalGoldNeeded += missingCosts[i];
-    }
-    return totalGoldNeeded;
+    TradeContext ctx = CostKernel::makeContext(buyer.production, opponent.production, buyer.tradeFixed);
+    return CostKernel::tradeCost(ctx, cost.resources, discount);
 }
-int Game::calculateCardCost(Player& buyer, Player& opponent, Card& card) {
+int Game::calculateCardCost(const Player& buyer, const Player& opponent, const Card& card) const {
     if (card.chainCost != NONE_CHAIN) {
-        if (buyer.chainIcons.count(card.chainCost)) return 0;
+        if (buyer.hasChain(card.chainCost)) return 0;
     }
     return calculateResourceCost(buyer, opponent, card.cost, card.type, false);
 }
 void Game::applyTokenImmediateEffect(Player& p, ProgressToken t) {
     if (t == P_AGRICULTURE || t == P_URBANISM) {
         p.coins += 6;
-        cout << ">>> 科技奖励：获得 6 金币！" << endl;
+        if (!headless) cout << ">>> 科技奖励：获得 6 金币！" << endl;
     }
 }
 void Game::checkScienceTokens(Player& p) {
-    map<ScienceSymbol, int> counts = p.scienceSymbols;
-    for(auto const& [sym, count] : counts) {
-        if(count == 2) {
+    for(int sym = GLOBE; sym <= QUILL; sym++) {
+        if(p.scienceSymbols[sym] == 2) {
             if(availableTokens.empty()) return;
             ProgressToken t = availableTokens.back();
             availableTokens.pop_back();
-            p.tokens.push_back(t);
-            cout << ">>> " << p.name << " 收集一对科技符号，获得: " << getTokenName(t) << endl;
+            p.addToken(t);
+            if (!headless) cout << ">>> " << p.name << " 收集一对科技符号，获得: " << getTokenName(t) << endl;
             applyTokenImmediateEffect(p, t);
             p.scienceSymbols[sym] = 3;
         }
@@ -216,7 +159,7 @@ void Game::applyMilitary(Player& attacker, int shields) {
             if (!milTokenP1_2) {
                 loss += 2;
                 milTokenP1_2 = true; // 移除标记
-                cout << ">>> [军事] P1 突破第1防线，移除 2金 惩罚标记。" << endl;
+                if (!headless) cout << ">>> [军事] P1 突破第1防线，移除 2金 惩罚标记。" << endl;
             }
         }
         // 检查 5分线 (范围: 5~8)
@@ -224,7 +167,7 @@ void Game::applyMilitary(Player& attacker, int shields) {
             if (!milTokenP1_5) {
                 loss += 5;
                 milTokenP1_5 = true; // 移除标记
-                cout << ">>> [军事] P1 突破第2防线，移除 5金 惩罚标记。" << endl;
+                if (!headless) cout << ">>> [军事] P1 突破第2防线，移除 5金 惩罚标记。" << endl;
             }
         }
     }
@@ -235,7 +178,7 @@ void Game::applyMilitary(Player& attacker, int shields) {
             if (!milTokenP2_2) {
                 loss += 2;
                 milTokenP2_2 = true;
-                cout << ">>> [军事] P2 突破第1防线，移除 2金 惩罚标记。" << endl;
+                if (!headless) cout << ">>> [军事] P2 突破第1防线，移除 2金 惩罚标记。" << endl;
             }
         }
         // 检查 5分线 (范围: -5~-8)
@@ -243,7 +186,7 @@ void Game::applyMilitary(Player& attacker, int shields) {
             if (!milTokenP2_5) {
                 loss += 5;
                 milTokenP2_5 = true;
-                cout << ">>> [军事] P2 突破第2防线，移除 5金 惩罚标记。" << endl;
+                if (!headless) cout << ">>> [军事] P2 突破第2防线，移除 5金 惩罚标记。" << endl;
             }
         }
     }
@@ -251,7 +194,7 @@ void Game::applyMilitary(Player& attacker, int shields) {
     if (loss > 0) {
         int actualLoss = min(defender.coins, loss);
         defender.coins -= actualLoss;
-        cout << "\n>>> [军事掠夺!] " << defender.name << " 失去了 " << actualLoss << " 金币! <<<\n" << endl;
+        if (!headless) cout << "\n>>> [军事掠夺!] " << defender.name << " 失去了 " << actualLoss << " 金币! <<<\n" << endl;
     }
 }
 
@@ -259,14 +202,14 @@ void Game::applyMilitary(Player& attacker, int shields) {
  * @brief 应用卡牌效果
  * 修正了 Strategy 科技币只对 MILITARY 卡牌生效的逻辑。
  */
-void Game::applyCardEffect(Player& p, Card& c) {
+void Game::applyCardEffect(Player& p, const Card& c) {
     p.victoryPoints += c.points;
     if (c.shields > 0) {
         // 只有当卡牌类型是 MILITARY 时，Strategy 科技币才加盾
         int bonus = 0;
         if (c.type == MILITARY && p.hasToken(P_STRATEGY)) {
             bonus = 1;
-            cout << ">>> [战略] 科技币生效，额外获得 1 盾牌！" << endl;
+            if (!headless) cout << ">>> [战略] 科技币生效，额外获得 1 盾牌！" << endl;
         }
         applyMilitary(p, c.shields + bonus);
     }
@@ -274,70 +217,69 @@ void Game::applyCardEffect(Player& p, Card& c) {
         p.scienceSymbols[c.science]++;
         checkScienceTokens(p);
     }
-    for(auto const& [res, count] : c.production) p.production[res] += count;
+    for(int res = WOOD; res <= PAPYRUS; res++) p.production[res] += c.production[res];
 
-    bool chained = (c.chainCost != NONE_CHAIN && p.chainIcons.count(c.chainCost));
+    bool chained = (c.chainCost != NONE_CHAIN && p.hasChain(c.chainCost));
     if(chained && p.hasToken(P_URBANISM)) {
         p.coins += 4;
-        cout << ">>> [城市规划] 奖励：获得 4 金币！" << endl;
+        if (!headless) cout << ">>> [城市规划] 奖励：获得 4 金币！" << endl;
     }
     p.coins += c.coinProduction;
-    if (c.chainProvide != NONE_CHAIN) p.chainIcons.insert(c.chainProvide);
-    if (c.tradeDiscountRes != NO_RES) p.tradeFixed[c.tradeDiscountRes] = true;
-    p.builtCards.push_back(c);
+    if (c.chainProvide != NONE_CHAIN) p.chainIcons |= 1u << c.chainProvide;
+    if (c.tradeDiscountRes != NO_RES) p.tradeFixed |= 1 << c.tradeDiscountRes;
+    p.builtCards.push_back(c.id);
 }
 
 /**
  * @brief 应用奇迹效果
+ * @return 是否获得额外回合 (奇迹自带或神学科技币)
  */
-void Game::applyWonderEffect(Player& p, Wonder& w) {
+bool Game::applyWonderEffect(Player& p, WonderSlot& slot) {
+    const Wonder& w = CardDatabase::getWonder(slot.id);
     p.victoryPoints += w.points;
     if (w.shields > 0) applyMilitary(p, w.shields);
     p.coins += w.coins;
-    w.built = true;
+    slot.built = true;
     PlayerStrategy* strat = (&p == &p1) ? strategyP1.get() : strategyP2.get();
     Player& opp = (&p == &p1) ? p2 : p1;
 
     // 摩索拉斯陵墓
-    if (w.name == "哈利卡納斯的摩索拉斯陵墓" || w.name == "Mausoleum") {
+    if (w.id == W_MAUSOLEUM) {
         if (!discardPile.empty()) {
-            int idx = strat->chooseCardFromDiscard(discardPile, *this);
+            int idx = strat->chooseCardFromDiscard(discardPile, GameView(*this, &p == &p1 ? 0 : 1));
             if (idx >= 0 && idx < discardPile.size()) {
-                Card picked = discardPile[idx];
+                const Card& picked = CardDatabase::getCard(discardPile[idx]);
                 discardPile.erase(discardPile.begin() + idx);
-                std::cout << ">>> 摩索拉斯陵墓复活了: " << picked.name << "\n";
+                if (!headless) std::cout << ">>> 摩索拉斯陵墓复活了: " << picked.name << "\n";
                 applyCardEffect(p, picked);
             }
         } else {
-            std::cout << ">>> 弃牌堆为空，无法复活卡牌。\n";
+            if (!headless) std::cout << ">>> 弃牌堆为空，无法复活卡牌。\n";
         }
     }
 
-    if (w.name == "奥林匹亞宙斯神像" || w.name == "Statue of Zeus") destroyCard(opp, RAW_MATERIAL);
-    if (w.name == "馬克西姆斯競技場" || w.name == "Circus Maximus") destroyCard(opp, MANUFACTURED);
+    if (w.id == W_STATUE_OF_ZEUS) destroyCard(opp, RAW_MATERIAL);
+    if (w.id == W_CIRCUS_MAXIMUS) destroyCard(opp, MANUFACTURED);
 
-    if (p.hasToken(P_THEOLOGY)) w.extraTurn = true;
-
-    if(w.name == "亚壁古道") {
+    if(w.id == W_APPIAN_WAY) {
         opp.coins = max(0, opp.coins - 3);
     }
 
     // 大图书馆：从盒子中随机抽3个，选1个
-    if((w.name == "大图书馆" || w.name == "The Great Library") && !boxTokens.empty()) {
+    if(w.id == W_GREAT_LIBRARY && !boxTokens.empty()) {
         std::vector<ProgressToken> options;
-        unsigned seed = std::chrono::system_clock::now().time_since_epoch().count();
-        std::shuffle(boxTokens.begin(), boxTokens.end(), std::default_random_engine(seed));
+        rng.shuffle(boxTokens.begin(), boxTokens.end());
 
         // 抽取最多3个
         int count = min((int)boxTokens.size(), 3);
         for(int i=0; i<count; i++) options.push_back(boxTokens[i]);
 
         // 让玩家选择
-        int choice = strat->chooseToken(options, *this);
+        int choice = strat->chooseToken(options, GameView(*this, &p == &p1 ? 0 : 1));
         if(choice >= 0 && choice < options.size()) {
             ProgressToken t = options[choice];
-            p.tokens.push_back(t);
-            cout << ">>> 大图书馆奖励: " << getTokenName(t) << endl;
+            p.addToken(t);
+            if (!headless) cout << ">>> 大图书馆奖励: " << getTokenName(t) << endl;
             applyTokenImmediateEffect(p, t);
 
             // 按照规则，剩下的应该放回盒子（这里boxTokens里还是乱序的，不需要特别处理，只是没被选中的还在里面）
@@ -351,40 +293,60 @@ void Game::applyWonderEffect(Player& p, Wonder& w) {
                  }
              }
         }
-    } else if (w.name == "大图书馆" && boxTokens.empty()) {
-        cout << ">>> 盒子中没有科技币了，大图书馆无法发动。" << endl;
+    } else if (w.id == W_GREAT_LIBRARY && boxTokens.empty()) {
+        if (!headless) cout << ">>> 盒子中没有科技币了，大图书馆无法发动。" << endl;
     }
+
+    return w.extraTurn || p.hasToken(P_THEOLOGY);
 }
 
 void Game::destroyCard(Player& targetPlayer, CardType targetType) {
-    std::vector<Card> targets;
+    std::vector<int> targets;
     std::vector<int> originalIndices;
     for(size_t i=0; i<targetPlayer.builtCards.size(); i++) {
-        if (targetPlayer.builtCards[i].type == targetType) {
+        if (CardDatabase::getCard(targetPlayer.builtCards[i]).type == targetType) {
             targets.push_back(targetPlayer.builtCards[i]);
             originalIndices.push_back(i);
         }
     }
     if (targets.empty()) {
-        std::cout << ">>> 对手没有可摧毁的卡牌。\n";
+        if (!headless) std::cout << ">>> 对手没有可摧毁的卡牌。\n";
         return;
     }
     PlayerStrategy* strat = (&targetPlayer == &p1) ? strategyP2.get() : strategyP1.get();
-    int choice = strat->chooseCardToDestroy(targets, *this);
+    int choice = strat->chooseCardToDestroy(targets, GameView(*this, &targetPlayer == &p1 ? 1 : 0));
     if (choice >= 0 && choice < targets.size()) {
         int removeIdx = originalIndices[choice];
-        Card removedCard = targetPlayer.builtCards[removeIdx];
-        std::cout << ">>> " << removedCard.name << " 被摧毁并移入弃牌堆！\n";
-        discardPile.push_back(removedCard);
+        const Card& removedCard = CardDatabase::getCard(targetPlayer.builtCards[removeIdx]);
+        if (!headless) std::cout << ">>> " << removedCard.name << " 被摧毁并移入弃牌堆！\n";
+        discardPile.push_back(removedCard.id);
         targetPlayer.builtCards.erase(targetPlayer.builtCards.begin() + removeIdx);
-        for(auto const& [res, count] : removedCard.production) {
-            targetPlayer.production[res] -= count;
+        for(int res = WOOD; res <= PAPYRUS; res++) {
+            targetPlayer.production[res] -= removedCard.production[res];
         }
     }
 }
-void Game::checkFaceUps() {
-    for (auto& slot : board) {
-        if (!slot.taken && !slot.faceUp && isAvailable(slot.id)) slot.faceUp = true;
+/**
+ * @brief 拿走一张牌，并只检查被它压住的牌是否因此可拿
+ */
+void Game::takeSlot(int id) {
+    if (takenMask & (1u << id)) return;
+    board[id].taken = true;
+    takenMask |= 1u << id;
+    availableMask &= ~(1u << id);
+    remainingCards--;
+    checkFaceUps(id);
+}
+/**
+ * @brief 翻开因 takenId 被拿走而露出的牌
+ * 被 takenId 压住、且所有覆盖者都已拿走的牌变为可拿并翻成正面。
+ */
+void Game::checkFaceUps(int takenId) {
+    for (uint32_t m = layout->slots[takenId].reveals; m; m &= m - 1) {
+        int id = countr_zero(m);
+        if (board[id].taken || (layout->slots[id].coveredBy & ~takenMask)) continue;
+        availableMask |= 1u << id;
+        board[id].faceUp = true;
     }
 }
 int Game::calculateGuildPoints(Player& owner, Player& opp, GuildType type) {
@@ -412,9 +374,9 @@ void Game::printState() {
         cout << "--- " << p.name << " ---" << endl;
         cout << "金币: " << p.coins << " | VP: " << p.victoryPoints << endl;
         cout << "资源: ";
-        for(auto const& [r, c] : p.production) if(c>0) cout << c << (r==WOOD?"木 ":r==CLAY?"土 ":r==STONE?"石 ":r==GLASS?"玻 ":"纸 ");
-        cout << "\n连锁: "; for(auto c : p.chainIcons) cout << getChainName(c) << " ";
-        cout << "\n奇迹: "; for(auto& w : p.wonders) if(w.built) cout << "[" << w.name << "] ";
+        for(int r = WOOD; r <= PAPYRUS; r++) if(p.production[r]>0) cout << (int)p.production[r] << getResourceName((Resource)r) << " ";
+        cout << "\n连锁: "; for(int c = JUG; c <= CHAIN_QUILL; c++) if(p.hasChain((ChainSymbol)c)) cout << getChainName((ChainSymbol)c) << " ";
+        cout << "\n奇迹: "; for(auto& w : p.wonders) if(w.built) cout << "[" << CardDatabase::getWonder(w.id).name << "] ";
         cout << endl;
     };
     printPlayer(p2);
@@ -423,78 +385,188 @@ void Game::printState() {
     if (avail.empty()) cout << "(本时代已无卡牌)" << endl;
     for(int id : avail) {
         BoardSlot& s = board[id];
-        int cost = calculateCardCost(p1Turn ? p1 : p2, p1Turn ? p2 : p1, s.card);
-        cout << "ID[" << (id<10?"0":"") << id << "] " << s.card.getTypeColor() << " " << s.card.name
-             << "\t| 费:" << cost << "\t| 效:" << s.card.getEffect() << endl;
+        const Card& card = CardDatabase::getCard(s.cardId);
+        int cost = calculateCardCost(p1Turn ? p1 : p2, p1Turn ? p2 : p1, card);
+        cout << "ID[" << (id<10?"0":"") << id << "] " << card.getTypeColor() << " " << card.name
+             << "\t| 费:" << cost << "\t| 效:" << card.getEffect() << endl;
     }
     cout << endl;
     printPlayer(p1);
 }
-int Game::getTotalBuiltWonders() {
+/**
+ * @brief 生成当前局面的紧凑快照
+ * 卡牌、奇迹只记录编号，集合全部转成位掩码。
+ */
+GameState Game::snapshot() const {
+    GameState s{};
+    auto pack = [](const Player& p, PlayerState& ps) {
+        ps.coins = p.coins;
+        ps.victoryPoints = p.victoryPoints;
+        memcpy(ps.production, p.production, sizeof ps.production);
+        memcpy(ps.scienceSymbols, p.scienceSymbols, sizeof ps.scienceSymbols);
+        ps.tradeFixed = p.tradeFixed;
+        ps.tokens = p.tokens;
+        ps.chainIcons = p.chainIcons;
+        ps.wonderCount = p.wonders.size();
+        for (int i = 0; i < p.wonders.size(); i++) {
+            ps.wonders[i] = p.wonders[i].id;
+            if (p.wonders[i].built) ps.wondersBuilt |= 1 << i;
+        }
+        for (int id : p.builtCards) ps.builtCards[id >> 6] |= 1ull << (id & 63);
+    };
+    pack(p1, s.players[0]);
+    pack(p2, s.players[1]);
+
+    for (auto& slot : board) {
+        s.slotCard[slot.id] = slot.cardId;
+        if (slot.taken) s.taken |= 1u << slot.id;
+        if (slot.faceUp) s.faceUp |= 1u << slot.id;
+    }
+    for (int id : discardPile) s.discardPile[id >> 6] |= 1ull << (id & 63);
+
+    s.militaryTrack = militaryTrack;
+    s.milTokens = (milTokenP1_2 ? 1 : 0) | (milTokenP1_5 ? 2 : 0) | (milTokenP2_2 ? 4 : 0) | (milTokenP2_5 ? 8 : 0);
+    s.age = currentAge;
+    s.activePlayer = p1Turn ? 0 : 1;
+    s.availableTokenCount = availableTokens.size();
+    for (int i = 0; i < availableTokens.size(); i++) s.availableTokens[i] = availableTokens[i];
+    s.boxTokenCount = boxTokens.size();
+    for (int i = 0; i < boxTokens.size(); i++) s.boxTokens[i] = boxTokens[i];
+    s.gameOver = gameOver;
+    s.winner = result.winner < 0 ? 0 : result.winner;
+    s.victory = result.victory;
+    s.rng = rng;
+    s.hash = s.computeHash();
+    return s;
+}
+
+/**
+ * @brief 从快照恢复局面 (玩家姓名、策略和扩展保持不变)
+ */
+void Game::restore(const GameState& s) {
+    auto unpack = [](const PlayerState& ps, Player& p) {
+        p.coins = ps.coins;
+        p.victoryPoints = ps.victoryPoints;
+        memcpy(p.production, ps.production, sizeof p.production);
+        memcpy(p.scienceSymbols, ps.scienceSymbols, sizeof p.scienceSymbols);
+        p.tradeFixed = ps.tradeFixed;
+        p.tokens = ps.tokens;
+        p.chainIcons = ps.chainIcons;
+        p.wonders.clear();
+        for (int i = 0; i < ps.wonderCount; i++) {
+            p.wonders.push_back({ps.wonders[i], (bool)((ps.wondersBuilt >> i) & 1)});
+        }
+        p.builtCards.clear();
+        for (int id = 0; id < CardDatabase::CARD_COUNT; id++) {
+            if ((ps.builtCards[id >> 6] >> (id & 63)) & 1) p.builtCards.push_back(id);
+        }
+    };
+    unpack(s.players[0], p1);
+    unpack(s.players[1], p2);
+
+    array<int, 20> deck;
+    for (int i = 0; i < 20; i++) deck[i] = s.slotCard[i];
+    layoutBoard(s.age, deck);
+    for (auto& slot : board) {
+        slot.taken = (s.taken >> slot.id) & 1;
+        slot.faceUp = (s.faceUp >> slot.id) & 1;
+    }
+    takenMask = s.taken;
+    remainingCards = 20 - popcount(s.taken);
+    availableMask = 0;
+    for (auto& slot : board) {
+        if (!slot.taken && (layout->slots[slot.id].coveredBy & ~takenMask) == 0) availableMask |= 1u << slot.id;
+    }
+    discardPile.clear();
+    for (int id = 0; id < CardDatabase::CARD_COUNT; id++) {
+        if ((s.discardPile[id >> 6] >> (id & 63)) & 1) discardPile.push_back(id);
+    }
+
+    militaryTrack = s.militaryTrack;
+    milTokenP1_2 = s.milTokens & 1;
+    milTokenP1_5 = s.milTokens & 2;
+    milTokenP2_2 = s.milTokens & 4;
+    milTokenP2_5 = s.milTokens & 8;
+    currentAge = s.age;
+    p1Turn = (s.activePlayer == 0);
+    availableTokens.clear();
+    for (int i = 0; i < s.availableTokenCount; i++) availableTokens.push_back((ProgressToken)s.availableTokens[i]);
+    boxTokens.clear();
+    for (int i = 0; i < s.boxTokenCount; i++) boxTokens.push_back((ProgressToken)s.boxTokens[i]);
+    gameOver = s.gameOver;
+    result.winner = gameOver ? s.winner : -1;
+    result.victory = gameOver ? (VictoryType)s.victory : V_NONE;
+    rng = s.rng;
+}
+int Game::getTotalBuiltWonders() const {
     return p1.getWonderCount() + p2.getWonderCount();
 }
 void Game::executeAction(Player& active, Player& passive, Action action) {
     BoardSlot& slot = board[action.cardId];
+    const Card& card = CardDatabase::getCard(slot.cardId);
     auto applyEconomy = [&](Player& spender, Player& earner, int amount) {
         if(amount > 0 && earner.hasToken(P_ECONOMY)) {
             earner.coins += 1;
-            cout << ">>> 经济学触发：" << earner.name << " 获得 1 金币税收！" << endl;
+            if (!headless) cout << ">>> 经济学触发：" << earner.name << " 获得 1 金币税收！" << endl;
         }
     };
     if (action.type == 1) {
-        CostBreakdown cost = calculateCostDetails(active, passive, slot.card.cost);
-        bool isFreeChain = (slot.card.chainCost != NONE_CHAIN && active.chainIcons.count(slot.card.chainCost));
+        CostBreakdown cost = calculateCostDetails(active, passive, card.cost);
+        bool isFreeChain = (card.chainCost != NONE_CHAIN && active.hasChain(card.chainCost));
         if (isFreeChain) {
             cost = {0, 0, 0};
             if (active.hasToken(P_URBANISM)) {
                 active.coins += 4;
-                cout << ">>> [城市规划] 连锁建造获得 4 金币！\n";
+                if (!headless) cout << ">>> [城市规划] 连锁建造获得 4 金币！\n";
             }
         }
         if (active.coins >= cost.totalCost) {
             active.coins -= cost.totalCost;
             passive.coins += cost.coinsToOpponent;
             if(cost.coinsToOpponent > 0)
-                cout << ">>> [经济学] " << passive.name << " 获得了 " << cost.coinsToOpponent << " 贸易金币！\n";
-            applyCardEffect(active, slot.card);
-            cout << active.name << " 建造了 " << slot.card.name << endl;
+                if (!headless) cout << ">>> [经济学] " << passive.name << " 获得了 " << cost.coinsToOpponent << " 贸易金币！\n";
+            applyCardEffect(active, card);
+            if (!headless) cout << active.name << " 建造了 " << card.name << endl;
             p1Turn = !p1Turn;
         } else {
-            cout << "错误：金币不足，自动转为弃牌。" << endl;
+            if (!headless) cout << "错误：金币不足，自动转为弃牌。" << endl;
             action.type = 2;
         }
     }
     if (action.type == 2) {
-        discardPile.push_back(slot.card);
+        discardPile.push_back(card.id);
         int gain = 2 + active.getYellowCount();
         active.coins += gain;
-        cout << active.name << " 弃掉了 " << slot.card.name << " 获得 " << gain << " 金币" << endl;
+        if (!headless) cout << active.name << " 弃掉了 " << card.name << " 获得 " << gain << " 金币" << endl;
         p1Turn = !p1Turn;
     }
     else if (action.type == 3) {
         if (getTotalBuiltWonders() >= 7) {
-            cout << ">>> [规则限制] 全场已建成 7 个奇迹，无法再建造！操作自动转为弃牌。 <<<" << endl;
+            if (!headless) cout << ">>> [规则限制] 全场已建成 7 个奇迹，无法再建造！操作自动转为弃牌。 <<<" << endl;
             int gain = 2 + active.getYellowCount();
             active.coins += gain;
-            cout << active.name << " 被迫弃掉了 " << slot.card.name << " 获得 " << gain << " 金币" << endl;
+            if (!headless) cout << active.name << " 被迫弃掉了 " << card.name << " 获得 " << gain << " 金币" << endl;
             p1Turn = !p1Turn;
         }
         else if(action.wonderIdx >= 0 && action.wonderIdx < active.wonders.size()) {
-            Wonder& w = active.wonders[action.wonderIdx];
+            WonderSlot& ws = active.wonders[action.wonderIdx];
+            const Wonder& w = CardDatabase::getWonder(ws.id);
             int wCost = calculateResourceCost(active, passive, w.cost, RAW_MATERIAL, true);
-            if (!w.built && active.coins >= wCost) {
+            if (!ws.built && active.coins >= wCost) {
                 active.coins -= wCost;
                 applyEconomy(active, passive, wCost);
-                applyWonderEffect(active, w);
-                cout << active.name << " 建造了奇迹: " << w.name << endl;
+                bool extraTurn = applyWonderEffect(active, ws);
+                if (!headless) cout << active.name << " 建造了奇迹: " << w.name << endl;
                 if (getTotalBuiltWonders() >= 7) {
-                    cout << "\n========================================================" << endl;
-                    cout << ">>> [规则触发] 第 7 个奇迹已建成！场上剩余的奇迹已被移除游戏！ <<<" << endl;
-                    cout << "========================================================" << endl;
-                    auto removeUnbuilt = [](Player& p) {
+                    if (!headless) {
+                        cout << "\n========================================================" << endl;
+                        cout << ">>> [规则触发] 第 7 个奇迹已建成！场上剩余的奇迹已被移除游戏！ <<<" << endl;
+                        cout << "========================================================" << endl;
+                    }
+                    auto removeUnbuilt = [this](Player& p) {
                         for (auto it = p.wonders.begin(); it != p.wonders.end(); ) {
                             if (!it->built) {
-                                cout << "--- " << p.name << " 的未建成奇迹 [" << it->name << "] 被移除。" << endl;
+                                if (!headless) cout << "--- " << p.name << " 的未建成奇迹 [" << CardDatabase::getWonder(it->id).name << "] 被移除。" << endl;
                                 it = p.wonders.erase(it);
                             } else {
                                 ++it;
@@ -504,78 +576,138 @@ void Game::executeAction(Player& active, Player& passive, Action action) {
                     removeUnbuilt(p1);
                     removeUnbuilt(p2);
                 }
-                if(w.extraTurn) cout << ">>> " << active.name << " 获得额外回合！" << endl;
+                if(extraTurn) {
+                    if (!headless) cout << ">>> " << active.name << " 获得额外回合！" << endl;
+                }
                 else p1Turn = !p1Turn;
             } else {
-                 cout << "错误：无法建造奇迹(钱不够或已建)，自动转为弃牌。" << endl;
+                 if (!headless) cout << "错误：无法建造奇迹(钱不够或已建)，自动转为弃牌。" << endl;
                  int gain = 2 + active.getYellowCount();
                  active.coins += gain;
                  p1Turn = !p1Turn;
             }
         }
     }
-    slot.taken = true;
-    checkFaceUps();
+    takeSlot(action.cardId);
 }
-CostBreakdown Game::calculateCostDetails(Player& buyer, Player& opponent, Cost cost) {
+CostBreakdown Game::calculateCostDetails(const Player& buyer, const Player& opponent, const Cost& cost) const {
     CostBreakdown cb;
     cb.coinsToBank = cost.coins;
-    for (auto const& [res, needed] : cost.resources) {
-        int produced = buyer.production[res];
-        if (produced < needed) {
-            int missing = needed - produced;
-            int oppProd = opponent.production[res];
-            int pricePerUnit = 2 + oppProd;
-            if (buyer.tradeFixed.count(res) && buyer.tradeFixed.at(res)) {
-                pricePerUnit = 1;
-            }
-            int tradeCost = missing * pricePerUnit;
-            if (opponent.hasToken(P_ECONOMY)) {
-                cb.coinsToOpponent += tradeCost;
-            } else {
-                cb.coinsToBank += tradeCost;
-            }
-        }
+    TradeContext ctx = CostKernel::makeContext(buyer.production, opponent.production, buyer.tradeFixed);
+    int tradeCost = CostKernel::tradeCost(ctx, cost.resources, 0);
+    if (opponent.hasToken(P_ECONOMY)) {
+        cb.coinsToOpponent += tradeCost;
+    } else {
+        cb.coinsToBank += tradeCost;
     }
     cb.totalCost = cb.coinsToBank + cb.coinsToOpponent;
     return cb;
 }
+/**
+ * @brief 批量计算当前所有可拿卡牌的费用
+ * 交易报价只生成一次，结果与逐张调用 calculateCardCost 相同，全程不分配内存。
+ * @param ids   输出：可拿卡牌的版图位置编号
+ * @param costs 输出：对应的费用
+ * @return 可拿卡牌的数量
+ */
+int Game::calculateAvailableCardCosts(const Player& buyer, const Player& opponent, int ids[20], int costs[20]) const {
+    TradeContext ctx = CostKernel::makeContext(buyer.production, opponent.production, buyer.tradeFixed);
+    int masonry = buyer.hasToken(P_MASONRY) ? 2 : 0;
+    int n = 0;
+    for (uint32_t m = availableMask; m; m &= m - 1) {
+        const BoardSlot& slot = board[countr_zero(m)];
+        const Card& card = CardDatabase::getCard(slot.cardId);
+        int cost;
+        if (card.chainCost != NONE_CHAIN && buyer.hasChain(card.chainCost)) cost = 0;
+        else if (card.cost.coins > 0) cost = card.cost.coins;
+        else cost = CostKernel::tradeCost(ctx, card.cost.resources, card.type == CIVILIAN ? masonry : 0);
+        ids[n] = slot.id;
+        costs[n] = cost;
+        n++;
+    }
+    return n;
+}
+int Game::generateLegalActions(const Player& active, const Player& passive, Action out[MAX_ACTIONS]) const {
+    // 建造是否买得起按 executeAction 实际扣费的口径 (calculateCostDetails) 判断，交易报价只生成一次
+    TradeContext ctx = CostKernel::makeContext(active.production, passive.production, active.tradeFixed);
+    // 奇迹的费用与拿哪张牌无关，先算好；已建成、买不起或全场已满 7 个的奇迹不列出
+    int wonderIdx[4], wonderCount = 0;
+    if (getTotalBuiltWonders() < 7) {
+        for (int w = 0; w < (int)active.wonders.size(); w++) {
+            const WonderSlot& ws = active.wonders[w];
+            if (ws.built) continue;
+            int wCost = calculateResourceCost(active, passive, CardDatabase::getWonder(ws.id).cost, RAW_MATERIAL, true);
+            if (active.coins >= wCost) wonderIdx[wonderCount++] = w;
+        }
+    }
+    int n = 0;
+    for (uint32_t m = availableMask; m; m &= m - 1) {
+        int id = countr_zero(m);
+        const Card& card = CardDatabase::getCard(board[id].cardId);
+        bool freeChain = card.chainCost != NONE_CHAIN && active.hasChain(card.chainCost);
+        if (freeChain || active.coins >= card.cost.coins + CostKernel::tradeCost(ctx, card.cost.resources, 0)) out[n++] = {1, id, -1};
+        out[n++] = {2, id, -1};
+        for (int k = 0; k < wonderCount; k++) out[n++] = {3, id, wonderIdx[k]};
+    }
+    return n;
+}
 void Game::checkInstantWin() {
     if (militaryTrack >= 9) {
         gameOver = true; winner = p1.name + " (军事压制)";
+        result.winner = 0; result.victory = V_MILITARY;
     } else if (militaryTrack <= -9) {
         gameOver = true; winner = p2.name + " (军事压制)";
+        result.winner = 1; result.victory = V_MILITARY;
     }
     if (p1.countScienceDistinct() >= 6) {
         gameOver = true; winner = p1.name + " (科技压制)";
+        result.winner = 0; result.victory = V_SCIENCE;
     } else if (p2.countScienceDistinct() >= 6) {
         gameOver = true; winner = p2.name + " (科技压制)";
+        result.winner = 1; result.victory = V_SCIENCE;
+    }
+    if (gameOver) {
+        result.scores[0] = calculateScore(p1, p2);
+        result.scores[1] = calculateScore(p2, p1);
     }
 }
+/**
+ * @brief 计算单个玩家的总分
+ * 胜利点 + 每3金币1分 + 军事优势 + 公会 + 科技币加分。
+ */
+int Game::calculateScore(Player& p, Player& opp) {
+    int track = (&p == &p1) ? militaryTrack : -militaryTrack;
+    int score = p.victoryPoints + p.coins/3 + (track > 0 ? track : 0);
+    for(int id : p.builtCards) {
+        const Card& c = CardDatabase::getCard(id);
+        if(c.type == GUILD) score += calculateGuildPoints(p, opp, c.guildType);
+    }
+    if(p.hasToken(P_AGRICULTURE)) score += 4;
+    if(p.hasToken(P_PHILOSOPHY)) score += 7;
+    if(p.hasToken(P_MATHEMATICS)) score += 3 * p.tokenCount();
+    return score;
+}
 void Game::calculateFinalScore() {
-    int p1Score = p1.victoryPoints + p1.coins/3 + (militaryTrack > 0 ? militaryTrack : 0);
-    int p2Score = p2.victoryPoints + p2.coins/3 + (militaryTrack < 0 ? abs(militaryTrack) : 0);
-    for(auto& c : p1.builtCards) if(c.type == GUILD) p1Score += calculateGuildPoints(p1, p2, c.guildType);
-    for(auto& c : p2.builtCards) if(c.type == GUILD) p2Score += calculateGuildPoints(p2, p1, c.guildType);
-    auto addTokenPoints = [&](Player& p, int& score) {
-        for(auto t : p.tokens) {
-            if(t == P_AGRICULTURE) score += 4;
-            if(t == P_PHILOSOPHY) score += 7;
-            if(t == P_MATHEMATICS) score += (3 * p.tokens.size());
-        }
-    };
-    addTokenPoints(p1, p1Score);
-    addTokenPoints(p2, p2Score);
-    cout << "\n=== 游戏结束 ===" << endl;
-    cout << p1.name << " 总分: " << p1Score << endl;
-    cout << p2.name << " 总分: " << p2Score << endl;
+    int p1Score = calculateScore(p1, p2);
+    int p2Score = calculateScore(p2, p1);
+    if (!headless) {
+        cout << "\n=== 游戏结束 ===" << endl;
+        cout << p1.name << " 总分: " << p1Score << endl;
+        cout << p2.name << " 总分: " << p2Score << endl;
+    }
     winner = (p1Score > p2Score) ? p1.name : p2.name;
+    result.winner = (p1Score > p2Score) ? 0 : 1;
+    result.victory = V_CIVILIAN;
+    result.scores[0] = p1Score;
+    result.scores[1] = p2Score;
 }
-void Game::run() {
+/**
+ * @brief 主循环：按时代推进，直到压制胜利或第三时代结束
+ * headless 模式下不打印局面、不等待回车。
+ */
+void Game::playLoop() {
     while (!gameOver) {
-        bool allTaken = true;
-        for(auto& s : board) if(!s.taken) allTaken = false;
-        if (allTaken) {
+        if (remainingCards == 0) {
             if (currentAge == 3) {
                 gameOver = true;
                 calculateFinalScore();
@@ -583,25 +715,34 @@ void Game::run() {
             }
             currentAge++;
             setupAge(currentAge);
-            cout << "\n>>> 进入时代 " << currentAge << " <<<\n";
+            if (!headless) cout << "\n>>> 进入时代 " << currentAge << " <<<\n";
             if(militaryTrack < 0) p1Turn = true;
             else if(militaryTrack > 0) p1Turn = false;
             continue;
         }
-        printState();
+        if (!headless) printState();
         checkInstantWin();
         if (gameOver) break;
         Player& active = p1Turn ? p1 : p2;
         Player& passive = p1Turn ? p2 : p1;
         PlayerStrategy* strat = p1Turn ? strategyP1.get() : strategyP2.get();
-        cout << "\n>>> 轮到 " << active.name << " 行动 <<<" << endl;
-        Action action = strat->makeDecision(*this, active, passive);
+        if (!headless) cout << "\n>>> 轮到 " << active.name << " 行动 <<<" << endl;
+        Action action = strat->makeDecision(GameView(*this, p1Turn ? 0 : 1));
         executeAction(active, passive, action);
-        if(!gameOver) {
+        result.moveCount++;
+        if(!gameOver && !headless) {
             cout << "按回车继续...";
             cin.ignore(10000, '\n');
             if(cin.peek() == '\n') cin.get();
         }
     }
+}
+void Game::run() {
+    playLoop();
     cout << "最终胜者: " << winner << endl;
-}
\ No newline at end of file
+}
+GameResult Game::simulate() {
+    headless = true;
+    playLoop();
+    return result;
+}
@@ -12,11 +12,19 @@
 #include "Enums.h"
 #include "Strategy.h"
 #include "Extension.h"
+#include "Random.h"
+#include "GameState.h"
+#include "CostKernel.h"
+#include "BoardLayout.h"
+#include <array>
 #include <vector>
 #include <string>
 #include <memory>
 
 class Game {
+    friend class GameBenchmark;     // bench.cpp 直接测量内部热点函数
+    friend class GameView;          // 策略的只读视图直接引用内部数据
+
 private:
     // --- 核心状态 ---
     Player p1;
@@ -25,7 +33,7 @@ private:
     std::unique_ptr<PlayerStrategy> strategyP2;
     std::vector<std::unique_ptr<Extension>> extensions;
 
-    std::vector<Card> discardPile;
+    std::vector<int> discardPile;   // 弃牌堆 (卡牌编号)
 
     int militaryTrack = 0;
     // 增加军事标记状态位，防止重复触发
@@ -35,7 +43,13 @@ private:
     bool milTokenP2_5 = false; // P2进攻达到5格 (即-5)
 
     int currentAge = 1;
-    std::vector<BoardSlot> board;
+    std::array<BoardSlot, 20> board{};
+    const AgeLayout* layout = nullptr;  // 当前时代的版图结构 (覆盖关系)
+
+    // 可拿牌的增量维护：拿走一张牌时只更新被它压住的牌
+    uint32_t takenMask = 0;         // 第 i 位 = 位置 i 已被拿走
+    uint32_t availableMask = 0;     // 第 i 位 = 位置 i 当前可拿
+    int remainingCards = 0;         // 本时代版图上剩余的牌数
 
     std::vector<ProgressToken> availableTokens; // 版图上的5个
     std::vector<ProgressToken> boxTokens;       // 留在盒子里的，供大图书馆使用
@@ -44,42 +58,78 @@ private:
     std::string winner = "";
     bool p1Turn = true;
 
+    Rng rng;                // 本局唯一的随机源：洗牌、抽公会、大图书馆都从这里取
+    bool headless = false;  // 无界面模式：不读写控制台，供批量模拟使用
+    GameResult result;      // 结构化的对局结果 (胜者、胜利方式、分数、行动数)
+
     // --- 内部逻辑方法 ---
     void initTokens();
-    std::vector<Card> getDeck(int age);
+    std::array<int, 20> getDeck(int age);
     void setupAge(int age);
+    void layoutBoard(int age, const std::array<int, 20>& deck);
     void dealWonders();
 
     bool isAvailable(int id);
+    void takeSlot(int id);
     void executeAction(Player& active, Player& passive, Action action);
 
     // 具体效果结算
     void applyMilitary(Player& attacker, int shields);
     void checkScienceTokens(Player& p);
     void applyTokenImmediateEffect(Player& p, ProgressToken t);
-    void applyCardEffect(Player& p, Card& c);
-    void applyWonderEffect(Player& p, Wonder& w);
-    void checkFaceUps();
+    void applyCardEffect(Player& p, const Card& c);
+    bool applyWonderEffect(Player& p, WonderSlot& slot);
+    void checkFaceUps(int takenId);
     int calculateGuildPoints(Player& owner, Player& opp, GuildType type);
     void checkInstantWin();
+    int calculateScore(Player& p, Player& opp);
     void calculateFinalScore();
     void printState();
+    void playLoop();
 
 public:
+    /**
+     * @param seed     随机种子，相同种子 + 相同决策可完整复现一局
+     * @param headless 为 true 时整局 (包括奇迹轮抽) 不访问 stdin/stdout，
+     *                 只能搭配 AI 策略使用
+     */
     Game(std::string p1Name, std::unique_ptr<PlayerStrategy> s1,
-         std::string p2Name, std::unique_ptr<PlayerStrategy> s2);
+         std::string p2Name, std::unique_ptr<PlayerStrategy> s2,
+         uint64_t seed, bool headless = false);
 
     std::vector<int> getAvailableCards();
-    Card& getCard(int id);
-    int calculateCardCost(Player& buyer, Player& opponent, Card& card);
-    static int calculateResourceCost(Player& buyer, Player& opponent, const Cost& cost, CardType type, bool isWonder);
-    CostBreakdown calculateCostDetails(Player& buyer, Player& opponent, Cost cost);
+    // 可拿牌位掩码，调用方可直接按位遍历而无需分配
+    uint32_t getAvailableMask() const { return availableMask; }
+    int getRemainingCards() const { return remainingCards; }
+    const Card& getCard(int id);
+    int calculateCardCost(const Player& buyer, const Player& opponent, const Card& card) const;
+    static int calculateResourceCost(const Player& buyer, const Player& opponent, const Cost& cost, CardType type, bool isWonder);
+    CostBreakdown calculateCostDetails(const Player& buyer, const Player& opponent, const Cost& cost) const;
+    int calculateAvailableCardCosts(const Player& buyer, const Player& opponent, int ids[20], int costs[20]) const;
+    /**
+     * @brief 列出 active 当前的全部合法行动，不分配内存
+     * 按可拿位置升序，每个位置依次为建造 (买得起或可连锁时)、弃牌、各个未建成且买得起的奇迹
+     * (全场奇迹未满 7 个时)，与 MCTSStrategy::generateMoves 的顺序一致。
+     * @return 写入 out 的行动数
+     */
+    int generateLegalActions(const Player& active, const Player& passive, Action out[MAX_ACTIONS]) const;
     void destroyCard(Player& targetPlayer, CardType targetType);
-    int getTotalBuiltWonders();
+    int getTotalBuiltWonders() const;
+    Rng& getRng() { return rng; }
+
+    // 紧凑快照：导出 / 恢复继续对局所需的全部状态
+    GameState snapshot() const;
+    void restore(const GameState& s);
     void run();
 
+    /**
+     * @brief 无界面批量模拟：从当前局面一直下到终局
+     * 不打印任何内容、不等待输入，对局结束后返回结构化结果。
+     */
+    GameResult simulate();
+
     void addExtension(std::unique_ptr<Extension> ext) {
-        std::cout << ">>> 激活扩展包: " << ext->getName() << " <<<" << std::endl;
+        if (!headless) std::cout << ">>> 激活扩展包: " << ext->getName() << " <<<" << std::endl;
         ext->onGameStart(*this);
         extensions.push_back(std::move(ext));
     }
@@ -0,0 +1,572 @@
+/**
+ * @file GameState.cpp
+ * @brief 在紧凑快照上推进规则
+ * 逐条镜像 Game.cpp 中的结算顺序 (包括其中的特殊处理)，只是不打印、不回调策略：
+ * 策略需要做的附带选择通过 executeAction 的 choice 参数传入。
+ * 修改 Game 的规则时必须同步修改这里。
+ */
+
+#include "GameState.h"
+#include "CardDatabase.h"
+#include "CostKernel.h"
+#include "BoardLayout.h"
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstring>
+
+using namespace std;
+
+static const uint32_t ALL_SLOTS = (1u << 20) - 1;
+
+/**
+ * @brief 按卡牌类型分组的卡牌编号位掩码
+ * 统计黄卡数量、查找可摧毁的卡牌时直接与 builtCards 做位运算。
+ */
+struct CardTypeMasks {
+    uint64_t byType[7][2] = {};
+    CardTypeMasks() {
+        for (int id = 0; id < CardDatabase::CARD_COUNT; id++) {
+            byType[CardDatabase::getCard(id).type][id >> 6] |= 1ull << (id & 63);
+        }
+    }
+};
+static const CardTypeMasks TYPE_MASKS;
+
+/**
+ * @brief Zobrist 随机键
+ * 用固定种子生成，同一份程序里相同局面的哈希值始终相同。
+ * 正面朝上的位置按 (位置, 卡牌) 取键，背面朝上的牌不参与哈希 (它们对行动方是未知的)。
+ */
+struct ZobristKeys {
+    static const int COIN_KEYS = 128;   // 金币超过 127 时与 127 共用一个键
+    static const int MILITARY_KEYS = 33; // 军事条 -16 ~ 16
+
+    uint64_t age[4];
+    uint64_t taken[20];
+    uint64_t faceUp[20][CardDatabase::CARD_COUNT];
+    uint64_t built[2][CardDatabase::CARD_COUNT];
+    uint64_t coins[2][COIN_KEYS];
+    uint64_t tokens[2][10];
+    uint64_t wonderBuilt[2][CardDatabase::WONDER_COUNT];
+    uint64_t military[MILITARY_KEYS];
+    uint64_t milTokens[4];
+    uint64_t sideToMove;    // activePlayer == 1 时异或进哈希
+
+    ZobristKeys() {
+        Rng rng(0x5A0B1A7ull);
+        uint64_t* first = age;
+        uint64_t* last = &sideToMove + 1;
+        for (uint64_t* k = first; k != last; k++) *k = rng();
+    }
+};
+static const ZobristKeys ZOBRIST;
+
+static bool hasBit(const uint64_t set[2], int id) { return (set[id >> 6] >> (id & 63)) & 1; }
+static void setBit(uint64_t set[2], int id) { set[id >> 6] |= 1ull << (id & 63); }
+static void clearBit(uint64_t set[2], int id) { set[id >> 6] &= ~(1ull << (id & 63)); }
+
+void GameState::setupAge(int newAge) {
+    AgeDeck deck = CardDatabase::loadCardsForAge(newAge, rng);
+    rng.shuffle(deck.begin(), deck.end());
+    const AgeLayout& layout = getAgeLayout(newAge);
+    taken = 0;
+    faceUp = 0;
+    for (int i = 0; i < 20; i++) {
+        slotCard[i] = deck[i];
+        if (layout.slots[i].faceUp) faceUp |= 1u << i;
+    }
+    age = newAge;
+    hash = computeHash();
+}
+
+/**
+ * @brief 金币、科技币、已建奇迹、军事条、掠夺标记、行动方这几项的哈希
+ * 这些字段在一步行动中会在多处被改动，executeAction 结束时按前后差值一次性更新。
+ */
+uint64_t GameState::scalarHash() const {
+    uint64_t h = 0;
+    for (int p = 0; p < 2; p++) {
+        const PlayerState& ps = players[p];
+        h ^= ZOBRIST.coins[p][min<int>(max<int>(ps.coins, 0), ZobristKeys::COIN_KEYS - 1)];
+        for (uint32_t m = ps.tokens; m; m &= m - 1) h ^= ZOBRIST.tokens[p][countr_zero(m)];
+        for (uint32_t m = ps.wondersBuilt; m; m &= m - 1) h ^= ZOBRIST.wonderBuilt[p][ps.wonders[countr_zero(m)]];
+    }
+    h ^= ZOBRIST.military[min(max(militaryTrack + 16, 0), ZobristKeys::MILITARY_KEYS - 1)];
+    for (uint32_t m = milTokens; m; m &= m - 1) h ^= ZOBRIST.milTokens[countr_zero(m)];
+    if (activePlayer) h ^= ZOBRIST.sideToMove;
+    return h;
+}
+
+uint64_t GameState::computeHash() const {
+    uint64_t h = ZOBRIST.age[age] ^ scalarHash();
+    for (uint32_t m = taken; m; m &= m - 1) h ^= ZOBRIST.taken[countr_zero(m)];
+    for (uint32_t m = faceUp; m; m &= m - 1) {
+        int i = countr_zero(m);
+        h ^= ZOBRIST.faceUp[i][slotCard[i]];
+    }
+    for (int p = 0; p < 2; p++) {
+        for (int w = 0; w < 2; w++) {
+            for (uint64_t m = players[p].builtCards[w]; m; m &= m - 1) h ^= ZOBRIST.built[p][w * 64 + countr_zero(m)];
+        }
+    }
+    return h;
+}
+
+uint32_t GameState::availableMask() const {
+    const AgeLayout& layout = getAgeLayout(age);
+    uint32_t mask = 0;
+    for (uint32_t m = ~taken & ALL_SLOTS; m; m &= m - 1) {
+        int id = countr_zero(m);
+        if ((layout.slots[id].coveredBy & ~taken) == 0) mask |= 1u << id;
+    }
+    return mask;
+}
+
+int GameState::totalBuiltWonders() const {
+    return popcount(players[0].wondersBuilt) + popcount(players[1].wondersBuilt);
+}
+
+int GameState::yellowCount(int p) const {
+    const uint64_t* yellow = TYPE_MASKS.byType[COMMERCIAL];
+    return popcount(players[p].builtCards[0] & yellow[0]) + popcount(players[p].builtCards[1] & yellow[1]);
+}
+
+int GameState::countScienceDistinct(int p) const {
+    int c = 0;
+    for (int sym = GLOBE; sym <= QUILL; sym++) {
+        if (players[p].scienceSymbols[sym] > 0) c++;
+    }
+    if ((players[p].tokens >> P_LAW) & 1) c++;
+    return c;
+}
+
+int GameState::calculateCardCost(int p, const Card& card) const {
+    const PlayerState& me = players[p];
+    if (card.chainCost != NONE_CHAIN && ((me.chainIcons >> card.chainCost) & 1)) return 0;
+    if (card.cost.coins > 0) return card.cost.coins;
+    int discount = (card.type == CIVILIAN && ((me.tokens >> P_MASONRY) & 1)) ? 2 : 0;
+    TradeContext ctx = CostKernel::makeContext(me.production, players[1 - p].production, me.tradeFixed);
+    return CostKernel::tradeCost(ctx, card.cost.resources, discount);
+}
+
+CostBreakdown GameState::calculateCostDetails(int p, const Cost& cost) const {
+    const PlayerState& me = players[p];
+    CostBreakdown cb;
+    cb.coinsToBank = cost.coins;
+    TradeContext ctx = CostKernel::makeContext(me.production, players[1 - p].production, me.tradeFixed);
+    int tradeCost = CostKernel::tradeCost(ctx, cost.resources, 0);
+    if ((players[1 - p].tokens >> P_ECONOMY) & 1) cb.coinsToOpponent += tradeCost;
+    else cb.coinsToBank += tradeCost;
+    cb.totalCost = cb.coinsToBank + cb.coinsToOpponent;
+    return cb;
+}
+
+int GameState::calculateWonderCost(int p, int idx) const {
+    const PlayerState& me = players[p];
+    const Wonder& w = CardDatabase::getWonder(me.wonders[idx]);
+    if (w.cost.coins > 0) return w.cost.coins;
+    int discount = ((me.tokens >> P_ARCHITECTURE) & 1) ? 2 : 0;
+    TradeContext ctx = CostKernel::makeContext(me.production, players[1 - p].production, me.tradeFixed);
+    return CostKernel::tradeCost(ctx, w.cost.resources, discount);
+}
+
+void GameState::applyTokenImmediateEffect(int p, ProgressToken t) {
+    if (t == P_AGRICULTURE || t == P_URBANISM) players[p].coins += 6;
+}
+
+void GameState::checkScienceTokens(int p) {
+    PlayerState& me = players[p];
+    for (int sym = GLOBE; sym <= QUILL; sym++) {
+        if (me.scienceSymbols[sym] == 2) {
+            if (availableTokenCount == 0) return;
+            ProgressToken t = (ProgressToken)availableTokens[--availableTokenCount];
+            availableTokens[availableTokenCount] = 0;
+            me.tokens |= 1 << t;
+            applyTokenImmediateEffect(p, t);
+            me.scienceSymbols[sym] = 3;
+        }
+    }
+}
+
+void GameState::applyMilitary(int attacker, int shields) {
+    int oldTrack = militaryTrack;
+    int loss = 0;
+    if (attacker == 0) {
+        militaryTrack += shields;
+        if (oldTrack < 2 && militaryTrack >= 2 && !(milTokens & 1)) { loss += 2; milTokens |= 1; }
+        if (oldTrack < 5 && militaryTrack >= 5 && !(milTokens & 2)) { loss += 5; milTokens |= 2; }
+    } else {
+        militaryTrack -= shields;
+        if (oldTrack > -2 && militaryTrack <= -2 && !(milTokens & 4)) { loss += 2; milTokens |= 4; }
+        if (oldTrack > -5 && militaryTrack <= -5 && !(milTokens & 8)) { loss += 5; milTokens |= 8; }
+    }
+    if (loss > 0) {
+        PlayerState& defender = players[1 - attacker];
+        defender.coins -= min<int>(defender.coins, loss);
+    }
+}
+
+void GameState::applyCardEffect(int p, const Card& c) {
+    PlayerState& me = players[p];
+    me.victoryPoints += c.points;
+    if (c.shields > 0) {
+        int bonus = (c.type == MILITARY && ((me.tokens >> P_STRATEGY) & 1)) ? 1 : 0;
+        applyMilitary(p, c.shields + bonus);
+    }
+    if (c.science != NO_SYMBOL) {
+        me.scienceSymbols[c.science]++;
+        checkScienceTokens(p);
+    }
+    for (int res = WOOD; res <= PAPYRUS; res++) me.production[res] += c.production[res];
+
+    bool chained = (c.chainCost != NONE_CHAIN && ((me.chainIcons >> c.chainCost) & 1));
+    if (chained && ((me.tokens >> P_URBANISM) & 1)) me.coins += 4;
+    me.coins += c.coinProduction;
+    if (c.chainProvide != NONE_CHAIN) me.chainIcons |= 1u << c.chainProvide;
+    if (c.tradeDiscountRes != NO_RES) me.tradeFixed |= 1 << c.tradeDiscountRes;
+    setBit(me.builtCards, c.id);
+    hash ^= ZOBRIST.built[p][c.id];
+}
+
+/**
+ * @brief 摧毁对手一张指定类型的卡牌 (对应 Game::destroyCard)
+ * 默认选择产量最高的一张。
+ */
+void GameState::destroyCard(int target, CardType targetType, int choice) {
+    PlayerState& victim = players[target];
+    const uint64_t* typeMask = TYPE_MASKS.byType[targetType];
+    uint64_t targets[2] = {victim.builtCards[0] & typeMask[0], victim.builtCards[1] & typeMask[1]};
+    if (!targets[0] && !targets[1]) return;
+
+    int picked = -1;
+    if (choice >= 0 && choice < CardDatabase::CARD_COUNT && hasBit(targets, choice)) {
+        picked = choice;
+    } else {
+        int best = -1;
+        for (int id = 0; id < CardDatabase::CARD_COUNT; id++) {
+            if (!hasBit(targets, id)) continue;
+            const Card& c = CardDatabase::getCard(id);
+            int prod = c.production[0] + c.production[1] + c.production[2] + c.production[3] + c.production[4];
+            if (prod > best) { best = prod; picked = id; }
+        }
+    }
+    const Card& removed = CardDatabase::getCard(picked);
+    setBit(discardPile, picked);
+    clearBit(victim.builtCards, picked);
+    hash ^= ZOBRIST.built[target][picked];
+    for (int res = WOOD; res <= PAPYRUS; res++) victim.production[res] -= removed.production[res];
+}
+
+/**
+ * @brief 应用奇迹效果 (对应 Game::applyWonderEffect)
+ * 默认选择：陵墓复活分数最高的卡，大图书馆拿第一个候选。
+ * @return 是否获得额外回合
+ */
+bool GameState::applyWonderEffect(int p, int idx, int choice) {
+    PlayerState& me = players[p];
+    PlayerState& opp = players[1 - p];
+    const Wonder& w = CardDatabase::getWonder(me.wonders[idx]);
+    me.victoryPoints += w.points;
+    if (w.shields > 0) applyMilitary(p, w.shields);
+    me.coins += w.coins;
+    me.wondersBuilt |= 1 << idx;
+
+    if (w.id == W_MAUSOLEUM && (discardPile[0] || discardPile[1])) {
+        int picked = -1;
+        if (choice >= 0 && choice < CardDatabase::CARD_COUNT && hasBit(discardPile, choice)) {
+            picked = choice;
+        } else {
+            int best = -1;
+            for (int id = 0; id < CardDatabase::CARD_COUNT; id++) {
+                if (hasBit(discardPile, id) && CardDatabase::getCard(id).points > best) {
+                    best = CardDatabase::getCard(id).points;
+                    picked = id;
+                }
+            }
+        }
+        clearBit(discardPile, picked);
+        applyCardEffect(p, CardDatabase::getCard(picked));
+    }
+
+    if (w.id == W_STATUE_OF_ZEUS) destroyCard(1 - p, RAW_MATERIAL, choice);
+    if (w.id == W_CIRCUS_MAXIMUS) destroyCard(1 - p, MANUFACTURED, choice);
+
+    if (w.id == W_APPIAN_WAY) opp.coins = max(0, opp.coins - 3);
+
+    // 大图书馆：与 Game 一样先洗盒子再取前 3 个；choice 为盒中的科技币时直接拿它
+    if (w.id == W_GREAT_LIBRARY && boxTokenCount > 0) {
+        rng.shuffle(boxTokens, boxTokens + boxTokenCount);
+        int pos = 0;
+        for (int i = 0; i < boxTokenCount; i++) {
+            if (boxTokens[i] == choice) pos = i;
+        }
+        ProgressToken t = (ProgressToken)boxTokens[pos];
+        me.tokens |= 1 << t;
+        applyTokenImmediateEffect(p, t);
+        for (int i = pos; i + 1 < boxTokenCount; i++) boxTokens[i] = boxTokens[i + 1];
+        boxTokens[--boxTokenCount] = 0;   // 空出的位置清零，与 Game::snapshot 的结果逐字节一致
+    }
+
+    return w.extraTurn || ((me.tokens >> P_THEOLOGY) & 1);
+}
+
+void GameState::takeSlot(int id) {
+    const AgeLayout& layout = getAgeLayout(age);
+    taken |= 1u << id;
+    hash ^= ZOBRIST.taken[id];
+    for (uint32_t m = layout.slots[id].reveals; m; m &= m - 1) {
+        int c = countr_zero(m);
+        if (!((taken >> c) & 1) && (layout.slots[c].coveredBy & ~taken) == 0 && !((faceUp >> c) & 1)) {
+            faceUp |= 1u << c;
+            hash ^= ZOBRIST.faceUp[c][slotCard[c]];
+        }
+    }
+}
+
+void GameState::executeAction(const Action& action, int choice) {
+    uint64_t scalarsBefore = scalarHash();
+    int p = activePlayer;
+    PlayerState& active = players[p];
+    PlayerState& passive = players[1 - p];
+    const Card& card = CardDatabase::getCard(slotCard[action.cardId]);
+    int type = action.type;
+
+    if (type == 1) {
+        CostBreakdown cost = calculateCostDetails(p, card.cost);
+        bool isFreeChain = (card.chainCost != NONE_CHAIN && ((active.chainIcons >> card.chainCost) & 1));
+        if (isFreeChain) {
+            cost = {0, 0, 0};
+            if ((active.tokens >> P_URBANISM) & 1) active.coins += 4;
+        }
+        if (active.coins >= cost.totalCost) {
+            active.coins -= cost.totalCost;
+            passive.coins += cost.coinsToOpponent;
+            applyCardEffect(p, card);
+            activePlayer = 1 - p;
+        } else {
+            type = 2;
+        }
+    }
+    if (type == 2) {
+        setBit(discardPile, card.id);
+        active.coins += 2 + yellowCount(p);
+        activePlayer = 1 - p;
+    }
+    else if (type == 3) {
+        if (totalBuiltWonders() >= 7) {
+            active.coins += 2 + yellowCount(p);
+            activePlayer = 1 - p;
+        }
+        else if (action.wonderIdx >= 0 && action.wonderIdx < active.wonderCount) {
+            int wCost = calculateWonderCost(p, action.wonderIdx);
+            bool built = (active.wondersBuilt >> action.wonderIdx) & 1;
+            if (!built && active.coins >= wCost) {
+                active.coins -= wCost;
+                if (wCost > 0 && ((passive.tokens >> P_ECONOMY) & 1)) passive.coins += 1;
+                bool extraTurn = applyWonderEffect(p, action.wonderIdx, choice);
+                if (totalBuiltWonders() >= 7) {
+                    // 第 7 个奇迹建成：移除所有未建成的奇迹，保持其余奇迹的先后顺序
+                    for (PlayerState& ps : players) {
+                        int n = 0;
+                        for (int i = 0; i < ps.wonderCount; i++) {
+                            if ((ps.wondersBuilt >> i) & 1) ps.wonders[n++] = ps.wonders[i];
+                        }
+                        for (int i = n; i < ps.wonderCount; i++) ps.wonders[i] = 0;
+                        ps.wonderCount = n;
+                        ps.wondersBuilt = (1 << n) - 1;
+                    }
+                }
+                if (!extraTurn) activePlayer = 1 - p;
+            } else {
+                active.coins += 2 + yellowCount(p);
+                activePlayer = 1 - p;
+            }
+        }
+    }
+    takeSlot(action.cardId);
+    hash ^= scalarsBefore ^ scalarHash();
+#ifdef ZOBRIST_DEBUG
+    assert(hashConsistent());
+#endif
+}
+
+/**
+ * @brief 两个卡牌位集合之差中的第一张 (a 中有而 b 中没有)，没有则返回 -1
+ * 一步行动中每类变化至多涉及两张卡，clearFirst 为 true 时顺便从 a 中去掉找到的那张。
+ */
+static int8_t firstDiff(uint64_t a[2], const uint64_t b[2], bool clearFirst = false) {
+    for (int w = 0; w < 2; w++) {
+        uint64_t d = a[w] & ~b[w];
+        if (d) {
+            int id = w * 64 + countr_zero(d);
+            if (clearFirst) clearBit(a, id);
+            return id;
+        }
+    }
+    return -1;
+}
+
+void GameState::applyMove(const Action& action, int choice, UndoStack& undo) {
+    int p = activePlayer;
+    PlayerState& me = players[p];
+    PlayerState& opp = players[1 - p];
+    MoveDelta& d = undo.deltas[undo.depth++];
+
+    // 预判会不会触发大范围改动：本时代最后一张牌 (发新牌)，或必定建成的大图书馆 / 第 7 个奇迹
+    bool checkpoint = popcount(taken) == 19 && age < 3;
+    int w = action.wonderIdx;
+    if (action.type == 3 && w >= 0 && w < me.wonderCount && !((me.wondersBuilt >> w) & 1)
+        && totalBuiltWonders() < 7 && me.coins >= calculateWonderCost(p, w)) {
+        if (me.wonders[w] == W_GREAT_LIBRARY || totalBuiltWonders() == 6) checkpoint = true;
+    }
+    if (checkpoint) {
+        d.checkpoint = undo.checkpointCount;
+        undo.checkpoints[undo.checkpointCount++] = *this;
+        executeAction(action, choice);
+        advance();
+        return;
+    }
+
+    d.checkpoint = -1;
+    d.slot = action.cardId;
+    d.mover = p;
+    d.faceUp = faceUp;
+    d.coins[0] = players[0].coins;
+    d.coins[1] = players[1].coins;
+    d.victoryPoints = me.victoryPoints;
+    memcpy(d.scienceSymbols, me.scienceSymbols, sizeof d.scienceSymbols);
+    d.tokens = me.tokens;
+    d.tradeFixed = me.tradeFixed;
+    d.wondersBuilt = me.wondersBuilt;
+    d.chainIcons = me.chainIcons;
+    d.militaryTrack = militaryTrack;
+    d.milTokens = milTokens;
+    memcpy(d.availableTokens, availableTokens, sizeof d.availableTokens);
+    d.availableTokenCount = availableTokenCount;
+    d.gameOver = gameOver;
+    d.winner = winner;
+    d.victory = victory;
+    d.hash = hash;
+    uint64_t myBuilt[2] = {me.builtCards[0], me.builtCards[1]};
+    uint64_t oppBuilt[2] = {opp.builtCards[0], opp.builtCards[1]};
+    uint64_t discard[2] = {discardPile[0], discardPile[1]};
+
+    executeAction(action, choice);
+    advance();
+
+    uint64_t gained[2] = {me.builtCards[0], me.builtCards[1]};
+    d.gained[0] = firstDiff(gained, myBuilt, true);
+    d.gained[1] = firstDiff(gained, myBuilt);
+    d.lost = firstDiff(oppBuilt, opp.builtCards);
+    d.discarded = firstDiff(discardPile, discard);
+    d.revived = firstDiff(discard, discardPile);
+}
+
+void GameState::undoMove(UndoStack& undo) {
+    const MoveDelta& d = undo.deltas[--undo.depth];
+    if (d.checkpoint >= 0) {
+        *this = undo.checkpoints[d.checkpoint];
+        undo.checkpointCount--;
+        return;
+    }
+    PlayerState& me = players[d.mover];
+    PlayerState& opp = players[1 - d.mover];
+    // 产量按卡牌属性加减 (uint8_t 回绕，与执行时的先后顺序无关)
+    for (int8_t id : d.gained) {
+        if (id < 0) continue;
+        clearBit(me.builtCards, id);
+        for (int r = WOOD; r <= PAPYRUS; r++) me.production[r] -= CardDatabase::getCard(id).production[r];
+    }
+    if (d.lost >= 0) {
+        setBit(opp.builtCards, d.lost);
+        for (int r = WOOD; r <= PAPYRUS; r++) opp.production[r] += CardDatabase::getCard(d.lost).production[r];
+    }
+    if (d.discarded >= 0) clearBit(discardPile, d.discarded);
+    if (d.revived >= 0) setBit(discardPile, d.revived);
+
+    taken &= ~(1u << d.slot);
+    faceUp = d.faceUp;
+    activePlayer = d.mover;
+    players[0].coins = d.coins[0];
+    players[1].coins = d.coins[1];
+    me.victoryPoints = d.victoryPoints;
+    memcpy(me.scienceSymbols, d.scienceSymbols, sizeof d.scienceSymbols);
+    me.tokens = d.tokens;
+    me.tradeFixed = d.tradeFixed;
+    me.wondersBuilt = d.wondersBuilt;
+    me.chainIcons = d.chainIcons;
+    militaryTrack = d.militaryTrack;
+    milTokens = d.milTokens;
+    memcpy(availableTokens, d.availableTokens, sizeof availableTokens);
+    availableTokenCount = d.availableTokenCount;
+    gameOver = d.gameOver;
+    winner = d.winner;
+    victory = d.victory;
+    hash = d.hash;
+}
+
+void GameState::advance() {
+    while (!gameOver) {
+        if (taken == ALL_SLOTS) {
+            if (age == 3) {
+                gameOver = true;
+                calculateFinalScore();
+                return;
+            }
+            setupAge(age + 1);
+            int before = activePlayer;
+            if (militaryTrack < 0) activePlayer = 0;
+            else if (militaryTrack > 0) activePlayer = 1;
+            if (activePlayer != before) hash ^= ZOBRIST.sideToMove;
+            continue;
+        }
+        checkInstantWin();
+        return;
+    }
+}
+
+void GameState::checkInstantWin() {
+    if (militaryTrack >= 9) {
+        gameOver = true; winner = 0; victory = V_MILITARY;
+    } else if (militaryTrack <= -9) {
+        gameOver = true; winner = 1; victory = V_MILITARY;
+    }
+    if (countScienceDistinct(0) >= 6) {
+        gameOver = true; winner = 0; victory = V_SCIENCE;
+    } else if (countScienceDistinct(1) >= 6) {
+        gameOver = true; winner = 1; victory = V_SCIENCE;
+    }
+}
+
+int GameState::calculateGuildPoints(int owner, GuildType type) const {
+    const PlayerState& me = players[owner];
+    switch (type) {
+        case G_MERCHANT: return max(yellowCount(0), yellowCount(1));
+        case G_SHIPOWNER: return me.production[WOOD] + me.production[CLAY] + me.production[STONE] + me.production[GLASS] + me.production[PAPYRUS];
+        case G_BUILDER: return max(popcount(players[0].wondersBuilt), popcount(players[1].wondersBuilt)) * 2;
+        case G_SCIENTIST: return 1;
+        default: return 0;
+    }
+}
+
+int GameState::calculateScore(int p) const {
+    const PlayerState& me = players[p];
+    int track = (p == 0) ? militaryTrack : -militaryTrack;
+    int score = me.victoryPoints + me.coins / 3 + (track > 0 ? track : 0);
+    const uint64_t* guilds = TYPE_MASKS.byType[GUILD];
+    for (int w = 0; w < 2; w++) {
+        for (uint64_t m = me.builtCards[w] & guilds[w]; m; m &= m - 1) {
+            score += calculateGuildPoints(p, CardDatabase::getCard(w * 64 + countr_zero(m)).guildType);
+        }
+    }
+    if ((me.tokens >> P_AGRICULTURE) & 1) score += 4;
+    if ((me.tokens >> P_PHILOSOPHY) & 1) score += 7;
+    if ((me.tokens >> P_MATHEMATICS) & 1) score += 3 * popcount(me.tokens);
+    return score;
+}
+
+void GameState::calculateFinalScore() {
+    winner = calculateScore(0) > calculateScore(1) ? 0 : 1;
+    victory = V_CIVILIAN;
+}
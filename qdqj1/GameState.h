@@ -0,0 +1,190 @@
+/**
+ * @file GameState.h
+ * @brief 紧凑的对局快照
+ * 作用：把 Game / Player / BoardSlot 中继续对局所需的全部信息压缩成一个
+ *      平凡可复制 (可 memcpy) 的结构体，卡牌和奇迹只保存编号。
+ *      供搜索类 AI 每秒克隆数百万次局面使用。
+ *      成员函数是 Game 规则在快照上的镜像实现 (见 GameState.cpp)，
+ *      同一局面、同一行动、同一副选择下两边的结果完全一致。
+ */
+
+#ifndef GAMESTATE_H
+#define GAMESTATE_H
+
+#include "Enums.h"
+#include "Random.h"
+#include "Structs.h"
+#include "Strategy.h"
+#include <cstdint>
+#include <type_traits>
+
+/**
+ * @struct PlayerState
+ * @brief 单个玩家的紧凑状态
+ * 所有集合都用位掩码表示：第 i 位对应枚举值 / 编号 i。
+ */
+struct PlayerState {
+    int16_t coins;              // 金币
+    int16_t victoryPoints;      // 直接获得的胜利点
+    uint8_t production[5];      // 按 Resource 下标的资源产量
+    uint8_t scienceSymbols[6];  // 按 ScienceSymbol 下标的符号数量 (3 表示已兑换过科技币)
+    uint8_t tradeFixed;         // 按 Resource 的贸易固定价格位
+    uint16_t tokens;            // 按 ProgressToken 的科技币位
+    uint32_t chainIcons;        // 按 ChainSymbol 的连锁符号位
+    uint8_t wonders[4];         // 奇迹编号，顺序与 Player::wonders 一致
+    uint8_t wonderCount;        // 奇迹数量 (第 7 个奇迹建成后未建成的会被移除)
+    uint8_t wondersBuilt;       // 第 i 位 = wonders[i] 已建成
+    uint64_t builtCards[2];     // 按卡牌编号的已建造卡牌位
+};
+
+/**
+ * @struct MoveDelta
+ * @brief 一步行动的可撤销记录
+ * 只保存这一步可能改动的字段的旧值；新增 / 移除的卡牌只记编号，产量变化由卡牌属性推出。
+ * 发新时代的牌、大图书馆洗盒子、第 7 个奇迹移除其余奇迹时改动面太大，
+ * 这几步改为在 UndoStack 中保存完整快照 (每条搜索路径上至多各发生一次)。
+ */
+struct MoveDelta {
+    int8_t checkpoint;          // >= 0 时为完整快照的下标，其余字段无效
+    uint8_t slot;               // 被拿走的版图位置
+    uint8_t mover;              // 行动方 (行动前的 activePlayer)
+    uint32_t faceUp;            // 行动前的正面朝上位
+    int16_t coins[2];           // 行动前双方的金币
+    int16_t victoryPoints;      // 以下均为行动方行动前的值
+    uint8_t scienceSymbols[6];
+    uint16_t tokens;
+    uint8_t tradeFixed;
+    uint8_t wondersBuilt;
+    uint32_t chainIcons;
+    int8_t gained[2];           // 行动方新建成的卡牌 (建造 + 陵墓复活)，-1 表示无
+    int8_t lost;                // 对手被摧毁的卡牌
+    int8_t discarded;           // 进入弃牌堆的卡牌 (弃牌或被摧毁)
+    int8_t revived;             // 离开弃牌堆的卡牌 (陵墓复活)
+    int8_t militaryTrack;
+    uint8_t milTokens;
+    uint8_t availableTokens[5];
+    uint8_t availableTokenCount;
+    uint8_t gameOver;
+    uint8_t winner;
+    uint8_t victory;
+    uint64_t hash;
+};
+
+class UndoStack;
+
+/**
+ * @struct GameState
+ * @brief 整局游戏的紧凑快照
+ * 版图结构由 age 决定 (见 Game::setupAge)，这里只记录每个位置的卡牌编号和状态位。
+ */
+struct GameState {
+    PlayerState players[2];     // 0 = 玩家1, 1 = 玩家2
+    uint8_t slotCard[20];       // 每个版图位置上的卡牌编号
+    uint32_t taken;             // 第 i 位 = 位置 i 已被拿走
+    uint32_t faceUp;            // 第 i 位 = 位置 i 正面朝上
+    uint64_t discardPile[2];    // 按卡牌编号的弃牌堆位
+    int8_t militaryTrack;       // 军事条位置 (正数偏向玩家1)
+    uint8_t milTokens;          // 军事掠夺标记: bit0 P1_2, bit1 P1_5, bit2 P2_2, bit3 P2_5
+    uint8_t age;                // 当前时代 1~3
+    uint8_t activePlayer;       // 轮到谁行动: 0 = 玩家1, 1 = 玩家2
+    uint8_t availableTokens[5]; // 版图上的科技币 (从末尾取)
+    uint8_t availableTokenCount;
+    uint8_t boxTokens[5];       // 盒子里的科技币 (大图书馆使用)
+    uint8_t boxTokenCount;
+    uint8_t gameOver;           // 对局是否已结束
+    uint8_t winner;             // 胜者 (gameOver 时有效)
+    uint8_t victory;            // VictoryType (gameOver 时有效)
+    Rng rng;                    // 后续发牌与大图书馆抽取使用的随机源
+    uint64_t hash;              // Zobrist 哈希，随 executeAction / advance 增量更新
+
+    // --- 规则推进 (与 Game 中的同名函数逐条对应，玩家用下标 0 / 1 表示) ---
+
+    /**
+     * @brief 执行一个行动 (对应 Game::executeAction)
+     * @param choice 该行动触发的附带选择：摩索拉斯陵墓复活的卡牌编号、
+     *               宙斯神像 / 竞技场摧毁的卡牌编号、大图书馆拿取的科技币。
+     *               -1 (或不合法的值) 表示使用默认选择。
+     */
+    void executeAction(const Action& action, int choice = -1);
+    /**
+     * @brief 推进到下一个决策点 (对应 Game::playLoop 每轮开头的检查)
+     * 本时代牌已拿完则进入下一时代或终局计分，否则检查压制胜利。
+     */
+    void advance();
+    // 按 age 的版图结构，用 rng 发一个时代的牌 (对应 Game::setupAge)
+    void setupAge(int newAge);
+
+    /**
+     * @brief 可撤销地走一步：executeAction + advance，并把改动记录压入 undo
+     * 深度优先搜索用它在同一个局面上来回走子，不需要为每个节点复制局面。
+     */
+    void applyMove(const Action& action, int choice, UndoStack& undo);
+    // 撤销 undo 中最近的一步，局面逐字节恢复到 applyMove 之前
+    void undoMove(UndoStack& undo);
+
+    uint32_t availableMask() const;
+    int totalBuiltWonders() const;
+    int yellowCount(int p) const;
+    // 对应 Game::calculateCardCost (连锁免费、砌体结构折扣)
+    int calculateCardCost(int p, const Card& card) const;
+    // 对应 Game::calculateCostDetails，建造卡牌时实际支付的金额
+    CostBreakdown calculateCostDetails(int p, const Cost& cost) const;
+    // 建造 p 的第 idx 个奇迹所需金币 (建筑学折扣)
+    int calculateWonderCost(int p, int idx) const;
+    int calculateScore(int p) const;
+    // owner 建有 type 公会卡时该卡的终局得分 (对应 Game::calculateGuildPoints)
+    int calculateGuildPoints(int owner, GuildType type) const;
+    int countScienceDistinct(int p) const;
+
+    /**
+     * @brief 从头计算 Zobrist 哈希
+     * 覆盖：时代、每个位置的拿走 / 正面朝上位 (正面朝上的按卡牌编号)、双方已建造卡牌、
+     * 金币、科技币、已建成奇迹、军事条位置、四个掠夺标记以及行动方。
+     * 背面朝上的牌和随机源不参与，因此抽样替换隐藏牌不会改变哈希。
+     */
+    uint64_t computeHash() const;
+    /**
+     * @brief 调试检查：增量维护的 hash 是否与从头计算的一致
+     * 定义 ZOBRIST_DEBUG 编译时，每次 executeAction 结束都会自动检查。
+     */
+    bool hashConsistent() const { return hash == computeHash(); }
+
+private:
+    uint64_t scalarHash() const;
+    void takeSlot(int id);
+    void applyMilitary(int attacker, int shields);
+    void checkScienceTokens(int p);
+    void applyTokenImmediateEffect(int p, ProgressToken t);
+    void applyCardEffect(int p, const Card& c);
+    bool applyWonderEffect(int p, int idx, int choice);
+    void destroyCard(int target, CardType targetType, int choice);
+    void checkInstantWin();
+    void calculateFinalScore();
+};
+
+static_assert(std::is_trivial_v<GameState> && std::is_standard_layout_v<GameState>,
+              "GameState 必须是 POD，才能直接 memcpy 克隆");
+static_assert(sizeof(GameState) <= 256, "GameState 应保持在几百字节以内");
+
+/**
+ * @class UndoStack
+ * @brief applyMove / undoMove 使用的撤销栈
+ * 容量按整局计算 (每个时代 20 步)，一次分配后反复使用，走子过程中不再分配内存。
+ */
+class UndoStack {
+public:
+    static const int MAX_DEPTH = 64;
+    static const int MAX_CHECKPOINTS = 8;
+
+    void clear() { depth = 0; checkpointCount = 0; }
+    int size() const { return depth; }
+
+private:
+    friend struct GameState;
+    MoveDelta deltas[MAX_DEPTH];
+    GameState checkpoints[MAX_CHECKPOINTS];
+    int depth = 0;
+    int checkpointCount = 0;
+};
+
+#endif
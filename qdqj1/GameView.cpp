@@ -0,0 +1,57 @@
+/**
+ * @file GameView.cpp
+ * @brief 只读对局视图的实现
+ */
+
+#include "GameView.h"
+#include "Game.h"
+#include <bit>
+
+using namespace std;
+
+GameView::GameView(const Game& game, int viewer) : game(game), self(viewer) {
+    slotCount = game.calculateAvailableCardCosts(player(self), player(1 - self), slotIds, slotCosts);
+}
+
+int GameView::activePlayer() const { return game.p1Turn ? 0 : 1; }
+int GameView::age() const { return game.currentAge; }
+const Player& GameView::player(int p) const { return p == 0 ? game.p1 : game.p2; }
+
+uint32_t GameView::availableMask() const { return game.availableMask; }
+uint32_t GameView::takenMask() const { return game.takenMask; }
+
+uint32_t GameView::faceUpMask() const {
+    uint32_t mask = 0;
+    for (const BoardSlot& slot : game.board) {
+        if (slot.faceUp) mask |= 1u << slot.id;
+    }
+    return mask;
+}
+
+int GameView::revealedCard(int slot) const {
+    if (slot < 0 || slot >= 20) return -1;
+    const BoardSlot& s = game.board[slot];
+    return s.faceUp && !s.taken ? s.cardId : -1;
+}
+
+int GameView::remainingCards() const { return game.remainingCards; }
+span<const int> GameView::discardPile() const { return game.discardPile; }
+span<const ProgressToken> GameView::availableTokens() const { return game.availableTokens; }
+int GameView::militaryTrack() const { return game.militaryTrack; }
+int GameView::totalBuiltWonders() const { return game.p1.getWonderCount() + game.p2.getWonderCount(); }
+
+int GameView::cardCost(const Card& card) const {
+    return game.calculateCardCost(player(self), player(1 - self), card);
+}
+
+int GameView::legalActions(Action out[MAX_ACTIONS]) const {
+    return game.generateLegalActions(player(self), player(1 - self), out);
+}
+
+GameState GameView::publicSnapshot() const {
+    GameState s = game.snapshot();
+    uint32_t hidden = ~(s.taken | s.faceUp) & ((1u << 20) - 1);
+    for (uint32_t m = hidden; m; m &= m - 1) s.slotCard[countr_zero(m)] = 0;
+    s.rng.reseed(0);
+    return s;
+}
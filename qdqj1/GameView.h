@@ -0,0 +1,78 @@
+/**
+ * @file GameView.h
+ * @brief 策略看到的只读对局视图
+ * 作用：Game 每次询问策略时构造一个 GameView 交给策略，策略只能通过它读取公开信息。
+ *      视图不复制对局数据：玩家、弃牌堆、科技币等都是指向 Game 内部的 const 引用或 span；
+ *      背面朝上的牌一律屏蔽；视图没有任何修改对局的途径。
+ *      视角玩家的可拿位置及其建造费用在构造时一次算好，之后的查询全部是只读的，
+ *      同一个视图可以同时交给多个搜索线程使用。
+ *      视图只在这一次询问期间有效，对局推进后其中的 span 会失效。
+ */
+
+#ifndef GAMEVIEW_H
+#define GAMEVIEW_H
+
+#include "GameState.h"
+#include "Player.h"
+#include "Strategy.h"
+#include "Structs.h"
+#include <cstdint>
+#include <span>
+
+class Game;
+
+class GameView {
+public:
+    /**
+     * @param viewer 视角玩家 (0 = 玩家1, 1 = 玩家2)，即这次被询问的一方
+     */
+    GameView(const Game& game, int viewer);
+
+    int viewer() const { return self; }
+    int activePlayer() const;
+    int age() const;
+
+    const Player& player(int p) const;
+    const Player& me() const { return player(self); }
+    const Player& opponent() const { return player(1 - self); }
+
+    // 可拿的版图位置 (按位置编号升序) 与视角玩家建造它们的费用，两者下标一一对应
+    std::span<const int> availableSlots() const { return {slotIds, (size_t)slotCount}; }
+    std::span<const int> availableCosts() const { return {slotCosts, (size_t)slotCount}; }
+
+    uint32_t availableMask() const;
+    uint32_t takenMask() const;
+    uint32_t faceUpMask() const;
+    // 版图上正面朝上且未拿走的位置返回卡牌编号，背面朝上或已拿走的返回 -1
+    int revealedCard(int slot) const;
+    int remainingCards() const;
+
+    std::span<const int> builtCards(int p) const { return player(p).builtCards; }
+    std::span<const WonderSlot> wonders(int p) const { return player(p).wonders; }
+    std::span<const int> discardPile() const;
+    std::span<const ProgressToken> availableTokens() const;
+    // 军事条位置 (正数偏向玩家1)
+    int militaryTrack() const;
+    int totalBuiltWonders() const;
+
+    // 视角玩家建造任意一张卡牌的费用 (连锁免费、砌体结构折扣，同 Game::calculateCardCost)
+    int cardCost(const Card& card) const;
+    // 视角玩家的全部合法行动 (见 Game::generateLegalActions)，返回写入 out 的个数
+    int legalActions(Action out[MAX_ACTIONS]) const;
+
+    /**
+     * @brief 只含公开信息的紧凑快照 (供搜索类策略使用)
+     * 背面朝上的位置一律记为 0 号卡，随机源换成固定种子，
+     * 需要隐藏信息时由策略自己抽样 (见 MCTSStrategy::determinize)。
+     */
+    GameState publicSnapshot() const;
+
+private:
+    const Game& game;
+    int self;
+    int slotIds[20];
+    int slotCosts[20];
+    int slotCount;
+};
+
+#endif
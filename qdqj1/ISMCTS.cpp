@@ -0,0 +1,171 @@
+/**
+ * @file ISMCTS.cpp
+ * @brief 信息集蒙特卡洛树搜索策略的实现
+ */
+
+#include "ISMCTS.h"
+#include "GameView.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <thread>
+
+using namespace std;
+
+static uint8_t moveCode(MCTSMove m) {
+    return encodeAction({m.type, m.cardId, m.wonderIdx});
+}
+
+static bool hasCode(const uint64_t set[2], uint8_t code) {
+    return (set[code >> 6] >> (code & 63)) & 1;
+}
+
+ISMCTSStrategy::ISMCTSStrategy(ISMCTSConfig config) : config(config), rng(config.seed) {}
+
+int ISMCTSStrategy::threadCount() const {
+    if (config.threads > 0) return config.threads;
+    return max(1u, thread::hardware_concurrency());
+}
+
+Action ISMCTSStrategy::makeDecision(const GameView& view) {
+    GameState snapshot = view.publicSnapshot();
+    MCTSMove rootMoves[MAX_ACTIONS];
+    int rootCount = MCTSStrategy::generateMoves(snapshot, rootMoves);
+    if (rootCount == 0) {
+        uint32_t avail = view.availableMask();
+        return {2, avail ? countr_zero(avail) : 0, -1};
+    }
+    if (rootCount == 1) return {rootMoves[0].type, rootMoves[0].cardId, rootMoves[0].wonderIdx};
+
+    vector<int> visits(rootCount, 0);
+    searchRoot(snapshot, visits);
+    int best = max_element(visits.begin(), visits.end()) - visits.begin();
+    return {rootMoves[best].type, rootMoves[best].cardId, rootMoves[best].wonderIdx};
+}
+
+int ISMCTSStrategy::selectChild(const NodeArena<Node>& arena, int parent, const uint64_t legal[2]) const {
+    int best = -1;
+    double bestScore = -1;
+    for (int c = arena[parent].firstChild; c >= 0; c = arena[c].nextSibling) {
+        const Node& n = arena[c];
+        if (!hasCode(legal, moveCode(n.move))) continue;
+        double score = n.wins / n.visits + config.exploration * sqrt(log((double)n.avail) / n.visits);
+        if (score > bestScore) { bestScore = score; best = c; }
+    }
+    return best;
+}
+
+/**
+ * @brief 在抽样局面 s 上做一次 选择 - 扩展 - 模拟 - 回传
+ * 每一层先列出本次抽样中的合法行动：已有子节点的可选次数加一，
+ * 还有没加入树的合法行动时随机加入一个并转入模拟，否则按 UCB 继续下降。
+ */
+void ISMCTSStrategy::iterate(Worker& w, GameState& s) {
+    NodeArena<Node>& arena = w.arena;
+    int path[128];
+    int depth = 0;
+    int cur = w.root;
+    path[depth++] = cur;
+    MCTSMove moves[MAX_ACTIONS];
+    while (!s.gameOver) {
+        int n = MCTSStrategy::generateMoves(s, moves);
+        uint64_t legal[2] = {}, untried[2] = {};
+        for (int i = 0; i < n; i++) {
+            uint8_t code = moveCode(moves[i]);
+            legal[code >> 6] |= 1ull << (code & 63);
+        }
+        untried[0] = legal[0];
+        untried[1] = legal[1];
+        for (int c = arena[cur].firstChild; c >= 0; c = arena[c].nextSibling) {
+            uint8_t code = moveCode(arena[c].move);
+            if (!hasCode(legal, code)) continue;
+            arena[c].avail++;
+            untried[code >> 6] &= ~(1ull << (code & 63));
+        }
+
+        int untriedCount = popcount(untried[0]) + popcount(untried[1]);
+        if (untriedCount > 0) {
+            int k = w.rng.below(untriedCount);
+            MCTSMove m = moves[0];
+            for (int i = 0; i < n; i++) {
+                if (hasCode(untried, moveCode(moves[i])) && k-- == 0) { m = moves[i]; break; }
+            }
+            // 节点内存用满时不加入新节点，直接从这一步开始模拟
+            int child = arena.allocate(1);
+            if (child >= 0) {
+                Node& node = arena[child];
+                node.move = m;
+                node.mover = s.activePlayer;
+                node.avail = 1;
+                node.nextSibling = arena[cur].firstChild;
+                arena[cur].firstChild = child;
+                path[depth++] = child;
+            }
+            MCTSStrategy::applyMove(s, m);
+            break;
+        }
+        cur = selectChild(arena, cur, legal);
+        MCTSStrategy::applyMove(s, arena[cur].move);
+        path[depth++] = cur;
+    }
+
+    int winner = MCTSStrategy::rollout(s, config.rollout, w.rng);
+    for (int i = 0; i < depth; i++) {
+        Node& n = arena[path[i]];
+        n.visits++;
+        if (n.mover == winner) n.wins += 1;
+    }
+}
+
+long ISMCTSStrategy::search(Worker& w, const GameState& snapshot, long iterations, chrono::steady_clock::time_point deadline) {
+    w.arena.nextGeneration();
+    w.root = w.arena.allocate(1);
+    w.arena[w.root].mover = 1 - snapshot.activePlayer;
+    long i = 0;
+    for (; ; i++) {
+        if (config.timeBudgetMs > 0) {
+            if ((i & 63) == 0 && chrono::steady_clock::now() >= deadline) break;
+        } else if (i >= iterations) {
+            break;
+        }
+        GameState s = snapshot;
+        MCTSStrategy::determinize(s, w.rng);
+        iterate(w, s);
+    }
+    return i;
+}
+
+long ISMCTSStrategy::searchRoot(const GameState& snapshot, vector<int>& visits) {
+    int n = threadCount();
+    // 种子在主线程里取，保证同一配置的搜索结果与线程调度无关
+    while ((int)workers.size() < n) workers.push_back(make_unique<Worker>(config.maxNodes, rng()));
+
+    auto deadline = chrono::steady_clock::now() + chrono::milliseconds(config.timeBudgetMs);
+    vector<long> playouts(n, 0);
+    if (n == 1) {
+        playouts[0] = search(*workers[0], snapshot, config.iterations, deadline);
+    } else {
+        vector<thread> threads;
+        for (int t = 0; t < n; t++) {
+            long quota = config.iterations / n + (t < config.iterations % n ? 1 : 0);
+            threads.emplace_back([&, t, quota] { playouts[t] = search(*workers[t], snapshot, quota, deadline); });
+        }
+        for (thread& th : threads) th.join();
+    }
+
+    // 根节点的合法行动只取决于公开信息，每个线程的根子节点都能在 rootMoves 中找到
+    MCTSMove rootMoves[MAX_ACTIONS];
+    int rootCount = MCTSStrategy::generateMoves(snapshot, rootMoves);
+    long total = 0;
+    for (int t = 0; t < n; t++) {
+        total += playouts[t];
+        const NodeArena<Node>& arena = workers[t]->arena;
+        for (int c = arena[workers[t]->root].firstChild; c >= 0; c = arena[c].nextSibling) {
+            uint8_t code = moveCode(arena[c].move);
+            for (int i = 0; i < rootCount; i++) {
+                if (moveCode(rootMoves[i]) == code) { visits[i] += arena[c].visits; break; }
+            }
+        }
+    }
+    return total;
+}
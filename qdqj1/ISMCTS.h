@@ -0,0 +1,89 @@
+/**
+ * @file ISMCTS.h
+ * @brief 信息集蒙特卡洛树搜索 (单观察者 ISMCTS) 策略
+ * 作用：MCTSStrategy 为固定的几个抽样局面各建一棵树，每棵树只见过一种隐藏牌。
+ *      本策略只建一棵以“行动序列”为节点的树，每次迭代都按已见信息重新抽样一次隐藏牌
+ *      (MCTSStrategy::determinize，不读取背面朝上的真实卡牌) 并换一个后续发牌的随机源，
+ *      在这个抽样局面上沿树下降，统计因此汇总在玩家实际面对的信息集上。
+ *      抽样不同，同一节点的合法行动也可能不同 (翻开的牌不同，买得起的就不同)：
+ *      子节点在第一次合法时才加入，UCB 的对数项用“该行动合法的次数”代替父节点访问次数。
+ *      多线程时每个线程独立搜索一棵树 (各自的抽样、随机源和节点竞技场)，
+ *      最后按根行动汇总访问次数。
+ */
+
+#ifndef ISMCTS_H
+#define ISMCTS_H
+
+#include "Strategy.h"
+#include "GameState.h"
+#include "MCTS.h"
+#include "NodeArena.h"
+#include "Random.h"
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * @struct ISMCTSConfig
+ * @brief 搜索参数
+ */
+struct ISMCTSConfig {
+    int iterations = 2000;          // 每次决策所有线程合计的迭代数 (timeBudgetMs > 0 时不使用)
+    int timeBudgetMs = 0;           // 每次决策的墙钟时间预算 (毫秒)，0 表示按迭代次数
+    int threads = 1;                // 搜索线程数，0 表示使用全部硬件线程
+    double exploration = 1.4;       // UCT 探索系数
+    RolloutPolicy rollout = ROLLOUT_GREEDY;
+    size_t maxNodes = 1 << 20;      // 每个线程的节点内存上限，用满后只模拟不扩展
+    uint64_t seed = 1;
+};
+
+class ISMCTSStrategy : public SearchStrategy {
+public:
+    explicit ISMCTSStrategy(ISMCTSConfig config = {});
+
+    Action makeDecision(const GameView& view) override;
+
+    /**
+     * @brief 在 snapshot 的信息集上搜索，把根节点各行动的访问次数累加到 visits
+     * visits 的下标与 generateMoves(snapshot) 的行动顺序一致。
+     * @return 所有线程合计完成的迭代次数
+     */
+    long searchRoot(const GameState& snapshot, std::vector<int>& visits);
+
+private:
+    /**
+     * @struct Node
+     * @brief 树节点：从父节点出发执行 move 后到达的信息集
+     * 子节点逐个加入，用 nextSibling 串成链表。
+     */
+    struct Node {
+        MCTSMove move;
+        uint8_t mover;          // 执行该行动的玩家
+        int firstChild = -1;
+        int nextSibling = -1;
+        int visits = 0;
+        int avail = 0;          // 该行动在多少次迭代中合法
+        float wins = 0;
+    };
+
+    // 每个搜索线程一份，跨决策保留 (节点内存复用)
+    struct Worker {
+        NodeArena<Node> arena;
+        Rng rng;
+        int root = -1;
+        Worker(size_t maxNodes, uint64_t seed) : arena(maxNodes), rng(seed) {}
+    };
+
+    ISMCTSConfig config;
+    Rng rng;
+    std::vector<std::unique_ptr<Worker>> workers;
+
+    int threadCount() const;
+    long search(Worker& w, const GameState& snapshot, long iterations, std::chrono::steady_clock::time_point deadline);
+    void iterate(Worker& w, GameState& s);
+    // 在本次抽样中合法 (legal 为 encodeAction 编码的位集) 的子节点中按 UCB 选一个
+    int selectChild(const NodeArena<Node>& arena, int parent, const uint64_t legal[2]) const;
+};
+
+#endif
@@ -0,0 +1,251 @@
+/**
+ * @file MCTS.cpp
+ * @brief 蒙特卡洛树搜索策略的实现
+ */
+
+#include "MCTS.h"
+#include "Rollout.h"
+#include "GameView.h"
+#include "CardDatabase.h"
+#include "CostKernel.h"
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cmath>
+
+using namespace std;
+
+MCTSStrategy::MCTSStrategy(MCTSConfig config)
+    : config(config), rng(config.seed),
+      arena(max<size_t>(config.maxNodes, 4 * max(1, config.determinizations))) {}
+
+int MCTSStrategy::generateMoves(const GameState& s, MCTSMove out[]) {
+    int p = s.activePlayer;
+    const PlayerState& me = s.players[p];
+    // 交易报价与可建的奇迹都与拿哪张牌无关，只算一次
+    TradeContext ctx = CostKernel::makeContext(me.production, s.players[1 - p].production, me.tradeFixed);
+    int8_t wonders[4];
+    int wonderCount = 0;
+    if (s.totalBuiltWonders() < 7) {
+        for (int8_t w = 0; w < me.wonderCount; w++) {
+            if (!((me.wondersBuilt >> w) & 1) && me.coins >= s.calculateWonderCost(p, w)) wonders[wonderCount++] = w;
+        }
+    }
+    int n = 0;
+    for (uint32_t m = s.availableMask(); m; m &= m - 1) {
+        int8_t id = countr_zero(m);
+        const Card& card = CardDatabase::getCard(s.slotCard[id]);
+        bool freeChain = card.chainCost != NONE_CHAIN && ((me.chainIcons >> card.chainCost) & 1);
+        if (freeChain || me.coins >= card.cost.coins + CostKernel::tradeCost(ctx, card.cost.resources, 0)) out[n++] = {1, id, -1};
+        out[n++] = {2, id, -1};
+        for (int k = 0; k < wonderCount; k++) out[n++] = {3, id, wonders[k]};
+    }
+    return n;
+}
+
+void MCTSStrategy::determinize(GameState& s, Rng& rng) {
+    uint32_t hidden = ~(s.taken | s.faceUp) & ((1u << 20) - 1);
+    s.rng.reseed(rng());
+    if (!hidden) return;
+
+    // 已见过的牌：拿走的 (建造、弃牌、垫奇迹都从这里来) 或正面朝上的位置
+    uint64_t seen[2] = {};
+    int seenGuilds = 0;
+    for (int i = 0; i < 20; i++) {
+        if ((hidden >> i) & 1) continue;
+        int id = s.slotCard[i];
+        seen[id >> 6] |= 1ull << (id & 63);
+        if (CardDatabase::getCard(id).type == GUILD) seenGuilds++;
+    }
+    // 本时代的牌堆 (见 CardDatabase::loadCardsForAge) 是全部非公会卡加随机 3 张公会卡，
+    // 洗匀后发 20 张、移出 3 张。见过的公会卡一定在牌堆里，其余名额从没见过的公会卡中
+    // 均匀抽取；隐藏位置再从牌堆里没见过的牌中均匀抽取，剩下的就是被移出的牌。
+    // 这样得到的正是给定已见信息时真实发牌的条件分布。
+    int pool[32], guildPool[8];
+    int n = 0, guilds = 0;
+    for (int id = 0; id < CardDatabase::CARD_COUNT; id++) {
+        const Card& c = CardDatabase::getCard(id);
+        if (c.age != s.age || ((seen[id >> 6] >> (id & 63)) & 1)) continue;
+        if (c.type == GUILD) guildPool[guilds++] = id;
+        else pool[n++] = id;
+    }
+    rng.shuffle(guildPool, guildPool + guilds);
+    for (int i = 0; i < 3 - seenGuilds && i < guilds; i++) pool[n++] = guildPool[i];
+    rng.shuffle(pool, pool + n);
+    int next = 0;
+    for (uint32_t m = hidden; m; m &= m - 1) s.slotCard[countr_zero(m)] = pool[next++];
+}
+
+/**
+ * @brief 用 UCT 公式选出最值得继续搜索的子节点，未访问过的子节点优先
+ */
+int MCTSStrategy::selectChild(const Node& parent) const {
+    double logN = log((double)parent.visits);
+    int best = parent.firstChild;
+    double bestScore = -1;
+    for (int i = parent.firstChild; i < parent.firstChild + parent.childCount; i++) {
+        const Node& c = arena[i];
+        if (c.visits == 0) return i;
+        double score = c.wins / c.visits + config.exploration * sqrt(logN / c.visits);
+        if (score > bestScore) { bestScore = score; best = i; }
+    }
+    return best;
+}
+
+// 节点内存用满时保持未扩展，之后到达这里的迭代直接从该节点开始模拟
+void MCTSStrategy::expand(int nodeIdx, const GameState& s) {
+    MCTSMove moves[MAX_ACTIONS];
+    int n = generateMoves(s, moves);
+    int first = arena.allocate(n);
+    if (first < 0) return;
+    for (int i = 0; i < n; i++) {
+        arena[first + i].move = moves[i];
+        arena[first + i].mover = s.activePlayer;
+    }
+    arena[nodeIdx].expanded = true;
+    arena[nodeIdx].firstChild = first;
+    arena[nodeIdx].childCount = n;
+}
+
+void MCTSStrategy::applyMove(GameState& s, MCTSMove m) {
+    s.executeAction({m.type, m.cardId, m.wonderIdx});
+    s.advance();
+}
+
+int MCTSStrategy::rollout(GameState& s, RolloutPolicy policy, Rng& rng) {
+    MCTSMove moves[MAX_ACTIONS];
+    while (!s.gameOver) {
+        int n = generateMoves(s, moves);
+        applyMove(s, Rollout::pickMove(policy, s, moves, n, rng));
+    }
+    return s.winner;
+}
+
+/**
+ * @brief 一次完整的 选择 - 扩展 - 模拟 - 回传
+ */
+void MCTSStrategy::iterate(int rootIdx, const GameState& root) {
+    GameState s = root;
+    int path[128];
+    int depth = 0;
+    int cur = rootIdx;
+    path[depth++] = cur;
+    while (arena[cur].expanded && arena[cur].childCount > 0) {
+        cur = selectChild(arena[cur]);
+        applyMove(s, arena[cur].move);
+        path[depth++] = cur;
+    }
+    if (!s.gameOver && !arena[cur].expanded) {
+        expand(cur, s);
+        if (arena[cur].childCount > 0) {
+            cur = arena[cur].firstChild + rng.below(arena[cur].childCount);
+            applyMove(s, arena[cur].move);
+            path[depth++] = cur;
+        }
+    }
+    int winner = rollout(s, config.rollout, rng);
+    for (int i = 0; i < depth; i++) {
+        Node& n = arena[path[i]];
+        n.visits++;
+        if (n.mover == winner) n.wins += 1;
+    }
+}
+
+Action MCTSStrategy::makeDecision(const GameView& view) {
+    GameState snapshot = view.publicSnapshot();
+    MCTSMove rootMoves[MAX_ACTIONS];
+    int rootCount = generateMoves(snapshot, rootMoves);
+    if (rootCount == 0) {
+        uint32_t avail = view.availableMask();
+        return {2, avail ? countr_zero(avail) : 0, -1};
+    }
+    if (rootCount == 1) return {rootMoves[0].type, rootMoves[0].cardId, rootMoves[0].wonderIdx};
+
+    vector<int> visits(rootCount, 0);
+    searchRoot(snapshot, visits);
+    int best = max_element(visits.begin(), visits.end()) - visits.begin();
+    return {rootMoves[best].type, rootMoves[best].cardId, rootMoves[best].wonderIdx};
+}
+
+int MCTSStrategy::findReusable(int nodeIdx, const GameState& s, const GameState& target, GameState& out, int depth) const {
+    if (depth > 0 && s.hash == target.hash) {
+        out = s;
+        return nodeIdx;
+    }
+    // 新时代的发牌是随机的，跨时代的子树不可能与实际局面一致
+    if (depth >= 4 || s.gameOver || s.age != target.age || !arena[nodeIdx].expanded) return -1;
+    const Node& n = arena[nodeIdx];
+    for (int c = n.firstChild; c < n.firstChild + n.childCount; c++) {
+        int slot = arena[c].move.cardId;
+        if (!((target.taken >> slot) & 1) || ((s.taken >> slot) & 1)) continue;
+        GameState next = s;
+        applyMove(next, arena[c].move);
+        int found = findReusable(c, next, target, out, depth + 1);
+        if (found >= 0) return found;
+    }
+    return -1;
+}
+
+void MCTSStrategy::keepSubtree(int oldIdx, int newIdx) {
+    copyQueue.clear();
+    copyQueue.push_back({oldIdx, newIdx});
+    for (size_t q = 0; q < copyQueue.size(); q++) {
+        auto [from, to] = copyQueue[q];
+        const Node& src = arena.previous(from);
+        arena[to] = src;
+        if (!src.expanded) continue;
+        int first = arena.allocate(src.childCount);
+        if (first < 0) {
+            arena[to].expanded = false;
+            arena[to].firstChild = -1;
+            arena[to].childCount = 0;
+            continue;
+        }
+        arena[to].firstChild = first;
+        for (int c = 0; c < src.childCount; c++) copyQueue.push_back({src.firstChild + c, first + c});
+    }
+}
+
+long MCTSStrategy::searchRoot(const GameState& snapshot, vector<int>& visits) {
+    // 根节点的合法行动只取决于公开信息，因此每棵树的根子节点顺序相同，可以直接按下标汇总
+    int treeCount = max(1, config.determinizations);
+
+    // 树复用：哈希不含背面朝上的牌，后代局面的哈希与当前局面相同即说明该树的抽样
+    // 与实际翻开的牌一致，子树里的隐藏牌仍是当前信息下合法的抽样
+    vector<GameState> next(treeCount, snapshot);
+    vector<int> kept(treeCount, -1);
+    if (config.reuseTree && (int)roots.size() == treeCount) {
+        for (int t = 0; t < treeCount; t++) kept[t] = findReusable(rootNodes[t], roots[t], snapshot, next[t], 0);
+    }
+
+    // 切换到新的一代：先为每棵树领取根节点，再复制保留的子树，其余节点整体作废
+    arena.nextGeneration();
+    rootNodes.assign(treeCount, -1);
+    for (int t = 0; t < treeCount; t++) rootNodes[t] = arena.allocate(1);
+    for (int t = 0; t < treeCount; t++) {
+        if (kept[t] >= 0) {
+            keepSubtree(kept[t], rootNodes[t]);
+        } else {
+            determinize(next[t], rng);
+            arena[rootNodes[t]].mover = 1 - snapshot.activePlayer;
+        }
+    }
+    roots.swap(next);
+
+    auto start = chrono::steady_clock::now();
+    long i = 0;
+    for (; ; i++) {
+        if (config.timeBudgetMs > 0) {
+            if ((i & 63) == 0 && chrono::steady_clock::now() - start >= chrono::milliseconds(config.timeBudgetMs)) break;
+        } else if (i >= config.iterations) {
+            break;
+        }
+        iterate(rootNodes[i % treeCount], roots[i % treeCount]);
+    }
+
+    for (int t = 0; t < treeCount; t++) {
+        const Node& root = arena[rootNodes[t]];
+        for (int c = 0; c < root.childCount; c++) visits[c] += arena[root.firstChild + c].visits;
+    }
+    return i;
+}
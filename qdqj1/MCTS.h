@@ -0,0 +1,128 @@
+/**
+ * @file MCTS.h
+ * @brief 蒙特卡洛树搜索 (UCT) 策略
+ * 作用：在 GameState 快照上做 UCT 搜索，模拟对局全部通过 GameState 的规则镜像推进，
+ *      不触碰 Game 本身。
+ *      背面朝上的牌视为隐藏信息：每次决策先按“本时代尚未出现的牌”随机重排这些位置，
+ *      并重置快照中的随机源 (后续时代的发牌、大图书馆抽取同样未知)，
+ *      在若干个这样的抽样局面上各建一棵树，最后汇总根节点的访问次数。
+ *      节点从策略自己的 NodeArena 中分配；下一次决策时，若某棵树中有后代局面
+ *      与新的局面一致，就保留那棵子树继续搜索 (树复用)。
+ */
+
+#ifndef MCTS_H
+#define MCTS_H
+
+#include "Strategy.h"
+#include "GameState.h"
+#include "NodeArena.h"
+#include "Random.h"
+#include <cstdint>
+#include <vector>
+
+/**
+ * @enum RolloutPolicy
+ * @brief 模拟阶段 (rollout) 的走子方式
+ */
+enum RolloutPolicy {
+    ROLLOUT_RANDOM,     // 在合法行动中均匀随机
+    ROLLOUT_GREEDY,     // 按简单估值挑最好的行动 (奇迹 > 高分卡 > 弃牌)
+    ROLLOUT_EPSILON,    // ε-贪心：多数时候挑每金币胜利分最高的行动，偶尔随机
+    ROLLOUT_MILITARY,   // 贪心 + 军事条形势
+    ROLLOUT_SCIENCE,    // 贪心 + 科技符号收集
+    ROLLOUT_CHAIN,      // 贪心 + 连锁
+    ROLLOUT_POLICY_COUNT
+};
+
+/**
+ * @struct MCTSConfig
+ * @brief 搜索参数
+ */
+struct MCTSConfig {
+    int iterations = 2000;          // 每次决策的迭代总数 (timeBudgetMs > 0 时不使用)
+    int timeBudgetMs = 0;           // 每次决策的时间预算 (毫秒)，0 表示按迭代次数
+    int determinizations = 8;       // 隐藏牌的抽样局面数，预算平均分给每棵树
+    double exploration = 1.4;       // UCT 探索系数
+    RolloutPolicy rollout = ROLLOUT_GREEDY;
+    uint64_t seed = 1;              // 搜索自身的随机种子 (不消耗 Game 的随机源)
+    size_t maxNodes = 1 << 20;      // 节点内存上限 (两代合计的节点数)，用满后只模拟不扩展
+    bool reuseTree = true;          // 是否保留上一次决策中与当前局面一致的子树
+};
+
+/**
+ * @struct MCTSMove
+ * @brief 搜索中的一个行动
+ * 与 Action 相同的三元组；陵墓、宙斯神像、竞技场的附带选择使用 GameState 的默认选择，
+ * 实际对局时由 SearchStrategy 的钩子做出同样的选择。
+ */
+struct MCTSMove {
+    int8_t type;        // 1:建造, 2:弃牌, 3:奇迹
+    int8_t cardId;      // 版图位置
+    int8_t wonderIdx;   // 奇迹序号 (type == 3 时有效)
+};
+
+class MCTSStrategy : public SearchStrategy {
+public:
+    explicit MCTSStrategy(MCTSConfig config = {});
+
+    Action makeDecision(const GameView& view) override;
+
+    // 生成 s 中行动方的全部合法行动 (与 GameState::executeAction 的判定一致)，返回数量
+    static int generateMoves(const GameState& s, MCTSMove out[]);
+    // 走一步并推进到下一个决策点 (executeAction + advance，附带选择用默认值，不可撤销)
+    static void applyMove(GameState& s, MCTSMove m);
+
+    /**
+     * @brief 把快照中的隐藏信息替换成随机抽样
+     * 背面朝上且未拿走的位置按已见信息下的条件分布重新发：牌堆中没见过的牌均匀分布，
+     * 第三时代牌堆里的 3 张公会卡先按已见的公会卡补全。随机源换成新的种子。
+     * 结果只取决于 s 的公开信息 (不读取隐藏位置原来的牌)。
+     */
+    static void determinize(GameState& s, Rng& rng);
+
+    /**
+     * @brief 从 s 一直模拟到终局，每一步按 policy 走子 (见 Rollout.h)
+     * @return 胜者 (0 / 1)
+     */
+    static int rollout(GameState& s, RolloutPolicy policy, Rng& rng);
+
+    /**
+     * @brief 在 snapshot 的若干抽样局面上搜索，把根节点各行动的访问次数累加到 visits
+     * visits 的下标与 generateMoves(snapshot) 的行动顺序一致 (根节点行动只取决于公开信息)。
+     * @return 完成的迭代 (模拟) 次数
+     */
+    long searchRoot(const GameState& snapshot, std::vector<int>& visits);
+
+private:
+    /**
+     * @struct Node
+     * @brief 搜索树节点
+     * 子节点在扩展时一次性生成，连续存放在 arena 中。
+     */
+    struct Node {
+        MCTSMove move;          // 从父节点走到这里的行动
+        uint8_t mover;          // 执行该行动的玩家 (胜负按这一方统计)
+        bool expanded = false;
+        int firstChild = -1;
+        int childCount = 0;
+        int visits = 0;
+        float wins = 0;
+    };
+
+    MCTSConfig config;
+    Rng rng;
+    NodeArena<Node> arena;
+    std::vector<GameState> roots;           // 每个抽样局面一棵树：根局面与根节点下标
+    std::vector<int> rootNodes;
+    std::vector<std::pair<int, int>> copyQueue;
+
+    void iterate(int rootIdx, const GameState& root);
+    int selectChild(const Node& parent) const;
+    void expand(int nodeIdx, const GameState& s);
+    // 在上一代的树中找与 target 一致的后代局面 (最多向下 4 步)，找到时把该局面写入 out
+    int findReusable(int nodeIdx, const GameState& s, const GameState& target, GameState& out, int depth) const;
+    // 把上一代中以 oldIdx 为根的子树复制到本代的 newIdx，内存不足时截断
+    void keepSubtree(int oldIdx, int newIdx);
+};
+
+#endif
@@ -0,0 +1,79 @@
+/**
+ * @file NodeArena.h
+ * @brief 搜索树节点的分代竞技场分配器
+ * 作用：搜索树每次决策要分配大量节点。节点按下标从竞技场里顺序领取，
+ *      不经过全局分配器，也不逐个释放；每个搜索线程 (策略对象) 持有自己的竞技场，
+ *      线程之间没有竞争。
+ *      竞技场分成两半轮流使用：开始新的一代时切换到另一半并整体清空 (O(1))，
+ *      上一代的一半在本代中仍然可读，需要保留的子树从那里复制过来即可，
+ *      其余节点不做任何处理就随之作废。
+ */
+
+#ifndef NODEARENA_H
+#define NODEARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @class NodeArena
+ * @brief 两代轮换的顺序分配器
+ * T 必须可平凡析构，清空一半时不需要逐个析构。
+ * 每一半在第一次分配时一次性预留 maxNodes / 2 个节点的容量，之后 allocate 只移动末尾、
+ * 从不重新分配或复制节点 (搜索中途不会出现整树搬家的停顿)，两代合计不超过 maxNodes 个节点；
+ * 预留的内存只有被用到的部分才会被写入 (由操作系统按页提交)。
+ * 达到上限后 allocate 返回 -1，由调用方降级处理 (例如不再扩展新节点，只做模拟)。
+ * 预留的内存跨代复用，不归还。
+ */
+template <typename T>
+class NodeArena {
+    static_assert(std::is_trivially_destructible_v<T>, "竞技场整体清空，节点不能有析构函数");
+
+public:
+    explicit NodeArena(size_t maxNodes = 1 << 20) : maxNodes(maxNodes) {}
+
+    // 开始新的一代：上一代的一半保留到下次切换前，可用 previous() 读取
+    void nextGeneration() {
+        current ^= 1;
+        halves[current].clear();
+        generation++;
+    }
+
+    /**
+     * @brief 在本代领取 count 个连续节点 (值初始化)
+     * @return 第一个节点的下标；超出内存上限时返回 -1
+     */
+    int allocate(int count) {
+        std::vector<T>& h = halves[current];
+        if (h.size() + count > maxNodes / 2) {
+            exhausted++;
+            return -1;
+        }
+        if (h.capacity() < maxNodes / 2) h.reserve(maxNodes / 2);
+        int first = (int)h.size();
+        h.resize(h.size() + count);
+        return first;
+    }
+
+    T& operator[](int i) { return halves[current][i]; }
+    const T& operator[](int i) const { return halves[current][i]; }
+    // 上一代的节点 (复制要保留的子树时使用)
+    const T& previous(int i) const { return halves[current ^ 1][i]; }
+
+    size_t size() const { return halves[current].size(); }
+    size_t limit() const { return maxNodes; }
+    uint32_t generationCount() const { return generation; }
+    // 因达到上限而失败的分配次数 (累计)
+    long exhaustedCount() const { return exhausted; }
+
+private:
+    std::vector<T> halves[2];
+    int current = 0;
+    size_t maxNodes;
+    uint32_t generation = 0;
+    long exhausted = 0;
+};
+
+#endif
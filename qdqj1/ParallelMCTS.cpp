@@ -0,0 +1,216 @@
+/**
+ * @file ParallelMCTS.cpp
+ * @brief 多线程蒙特卡洛树搜索策略的实现
+ */
+
+#include "ParallelMCTS.h"
+#include "GameView.h"
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+using namespace std;
+
+ParallelMCTSStrategy::ParallelMCTSStrategy(ParallelMCTSConfig config)
+    : config(config), rng(config.seed) {}
+
+int ParallelMCTSStrategy::threadCount() const {
+    if (config.threads > 0) return config.threads;
+    return max(1u, thread::hardware_concurrency());
+}
+
+Action ParallelMCTSStrategy::makeDecision(const GameView& view) {
+    GameState snapshot = view.publicSnapshot();
+    MCTSMove rootMoves[MAX_ACTIONS];
+    int rootCount = MCTSStrategy::generateMoves(snapshot, rootMoves);
+    if (rootCount == 0) {
+        uint32_t avail = view.availableMask();
+        return {2, avail ? countr_zero(avail) : 0, -1};
+    }
+    if (rootCount == 1) return {rootMoves[0].type, rootMoves[0].cardId, rootMoves[0].wonderIdx};
+
+    vector<int> visits(rootCount, 0);
+    searchRoot(snapshot, visits);
+    int best = max_element(visits.begin(), visits.end()) - visits.begin();
+    return {rootMoves[best].type, rootMoves[best].cardId, rootMoves[best].wonderIdx};
+}
+
+long ParallelMCTSStrategy::searchRoot(const GameState& snapshot, vector<int>& visits) {
+    if (config.mode == PARALLEL_ROOT) return searchRootParallel(snapshot, visits);
+    return searchTreeParallel(snapshot, visits);
+}
+
+// --- 根并行 ---
+
+long ParallelMCTSStrategy::searchRootParallel(const GameState& snapshot, vector<int>& visits) {
+    int n = threadCount();
+    // 种子在主线程里取，保证同一配置的搜索结果与线程调度无关
+    while ((int)workers.size() < n) {
+        int t = workers.size();
+        MCTSConfig c;
+        c.iterations = config.iterations / n + (t < config.iterations % n ? 1 : 0);
+        c.timeBudgetMs = config.timeBudgetMs;
+        c.determinizations = config.determinizations;
+        c.exploration = config.exploration;
+        c.rollout = config.rollout;
+        c.maxNodes = config.nodeCapacity;
+        c.seed = rng();
+        workers.push_back(make_unique<MCTSStrategy>(c));
+    }
+
+    vector<vector<int>> partial(n, vector<int>(visits.size(), 0));
+    vector<long> playouts(n, 0);
+    vector<thread> threads;
+    for (int t = 0; t < n; t++) {
+        threads.emplace_back([&, t] { playouts[t] = workers[t]->searchRoot(snapshot, partial[t]); });
+    }
+    long total = 0;
+    for (int t = 0; t < n; t++) {
+        threads[t].join();
+        for (size_t i = 0; i < visits.size(); i++) visits[i] += partial[t][i];
+        total += playouts[t];
+    }
+    return total;
+}
+
+// --- 树并行 ---
+
+int ParallelMCTSStrategy::allocate(int count) {
+    // 先检查再领取，避免池满之后计数器被反复加到溢出
+    if (poolUsed.load(memory_order_relaxed) + count > config.nodeCapacity) return -1;
+    int first = poolUsed.fetch_add(count, memory_order_relaxed);
+    if (first + count > config.nodeCapacity) return -1;
+    for (int i = first; i < first + count; i++) {
+        SharedNode& node = pool[i];
+        node.state.store(0, memory_order_relaxed);
+        node.firstChild = -1;
+        node.childCount = 0;
+        node.visits.store(0, memory_order_relaxed);
+        node.wins.store(0, memory_order_relaxed);
+    }
+    return first;
+}
+
+/**
+ * @brief 用 UCT 公式选子节点
+ * 虚拟损失已经计入 visits (但不计入 wins)，正在被其他线程搜索的分支得分会暂时偏低。
+ */
+int ParallelMCTSStrategy::selectChild(const SharedNode& parent) const {
+    double logN = log((double)max(1, parent.visits.load(memory_order_relaxed)));
+    int best = parent.firstChild;
+    double bestScore = -1;
+    for (int i = parent.firstChild; i < parent.firstChild + parent.childCount; i++) {
+        const SharedNode& c = pool[i];
+        int visits = c.visits.load(memory_order_relaxed);
+        if (visits == 0) return i;
+        double score = (double)c.wins.load(memory_order_relaxed) / visits + config.exploration * sqrt(logN / visits);
+        if (score > bestScore) { bestScore = score; best = i; }
+    }
+    return best;
+}
+
+/**
+ * @brief 扩展节点：只有把 state 从 0 改成 1 的线程负责扩展，其余线程把它当叶子直接模拟
+ * 子节点全部写好后才以 release 语义发布 state = 2。
+ * @return 本线程完成了扩展且有子节点
+ */
+bool ParallelMCTSStrategy::expand(int nodeIdx, const GameState& s) {
+    SharedNode& node = pool[nodeIdx];
+    uint8_t expected = 0;
+    if (!node.state.compare_exchange_strong(expected, 1, memory_order_acquire)) return false;
+
+    MCTSMove moves[MAX_ACTIONS];
+    int n = MCTSStrategy::generateMoves(s, moves);
+    int first = n > 0 ? allocate(n) : -1;
+    if (first >= 0) {
+        for (int i = 0; i < n; i++) {
+            pool[first + i].move = moves[i];
+            pool[first + i].mover = s.activePlayer;
+        }
+        node.firstChild = first;
+        node.childCount = n;
+    }
+    node.state.store(2, memory_order_release);
+    return first >= 0;
+}
+
+void ParallelMCTSStrategy::iterate(int rootIdx, const GameState& root, Rng& rng) {
+    const int vl = config.virtualLoss;
+    GameState s = root;
+    int path[128];
+    int depth = 0;
+    int cur = rootIdx;
+    path[depth++] = cur;
+    while (pool[cur].state.load(memory_order_acquire) == 2 && pool[cur].childCount > 0) {
+        cur = selectChild(pool[cur]);
+        pool[cur].visits.fetch_add(vl, memory_order_relaxed);
+        MCTSStrategy::applyMove(s, pool[cur].move);
+        path[depth++] = cur;
+    }
+    if (!s.gameOver && expand(cur, s)) {
+        cur = pool[cur].firstChild + rng.below(pool[cur].childCount);
+        pool[cur].visits.fetch_add(vl, memory_order_relaxed);
+        MCTSStrategy::applyMove(s, pool[cur].move);
+        path[depth++] = cur;
+    }
+    int winner = MCTSStrategy::rollout(s, config.rollout, rng);
+    // 回传：把选择时记入的虚拟损失换成真实结果 (根节点没有记虚拟损失)
+    for (int i = 0; i < depth; i++) {
+        SharedNode& node = pool[path[i]];
+        node.visits.fetch_add(i == 0 ? 1 : 1 - vl, memory_order_relaxed);
+        if (node.mover == winner) node.wins.fetch_add(1, memory_order_relaxed);
+    }
+}
+
+long ParallelMCTSStrategy::searchTreeParallel(const GameState& snapshot, vector<int>& visits) {
+    if (!pool) pool = make_unique<SharedNode[]>(config.nodeCapacity);
+    poolUsed.store(0, memory_order_relaxed);
+
+    int treeCount = max(1, config.determinizations);
+    vector<GameState> roots(treeCount, snapshot);
+    vector<int> rootIdx(treeCount);
+    for (int t = 0; t < treeCount; t++) {
+        MCTSStrategy::determinize(roots[t], rng);
+        rootIdx[t] = allocate(1);
+        pool[rootIdx[t]].mover = 1 - snapshot.activePlayer;
+    }
+
+    int n = threadCount();
+    vector<uint64_t> seeds(n);
+    for (int t = 0; t < n; t++) seeds[t] = rng();
+    atomic<long> claimed{0};
+    auto deadline = chrono::steady_clock::now() + chrono::milliseconds(config.timeBudgetMs);
+    vector<thread> threads;
+    vector<long> playouts(n, 0);
+    for (int t = 0; t < n; t++) {
+        threads.emplace_back([&, t] {
+            Rng local(seeds[t]);
+            for (long i = t; ; i++) {
+                int tree;
+                if (config.timeBudgetMs > 0) {
+                    if ((i & 15) == 0 && chrono::steady_clock::now() >= deadline) break;
+                    tree = i % treeCount;
+                } else {
+                    long k = claimed.fetch_add(1, memory_order_relaxed);
+                    if (k >= config.iterations) break;
+                    tree = k % treeCount;
+                }
+                iterate(rootIdx[tree], roots[tree], local);
+                playouts[t]++;
+            }
+        });
+    }
+    long total = 0;
+    for (int t = 0; t < n; t++) {
+        threads[t].join();
+        total += playouts[t];
+    }
+
+    for (int t = 0; t < treeCount; t++) {
+        const SharedNode& root = pool[rootIdx[t]];
+        for (int c = 0; c < root.childCount; c++) visits[c] += pool[root.firstChild + c].visits.load(memory_order_relaxed);
+    }
+    return total;
+}
@@ -0,0 +1,97 @@
+/**
+ * @file ParallelMCTS.h
+ * @brief 多线程蒙特卡洛树搜索策略
+ * 作用：在 makeDecision 内部启动若干搜索线程，返回前全部汇合，
+ *      对 Game::run 来说与单线程策略没有区别。提供两种并行方式：
+ *      根并行：每个线程独立地跑一个 MCTSStrategy (各自的抽样局面、树和节点竞技场)，
+ *              最后汇总根节点的访问次数；线程之间不共享任何数据。
+ *              这些 MCTSStrategy 跨决策保留，各自复用上一步的子树。
+ *      树并行：所有线程在同一组共享树上搜索，节点统计是原子变量，
+ *              选择时加“虚拟损失”，让并发的线程分散到不同的分支上。
+ */
+
+#ifndef PARALLELMCTS_H
+#define PARALLELMCTS_H
+
+#include "Strategy.h"
+#include "GameState.h"
+#include "MCTS.h"
+#include "Random.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * @enum ParallelMode
+ * @brief 并行方式
+ */
+enum ParallelMode {
+    PARALLEL_ROOT,  // 根并行：每个线程独立的树
+    PARALLEL_TREE   // 树并行：共享的树 + 虚拟损失
+};
+
+/**
+ * @struct ParallelMCTSConfig
+ * @brief 搜索参数
+ */
+struct ParallelMCTSConfig {
+    ParallelMode mode = PARALLEL_TREE;
+    int threads = 0;                // 搜索线程数，0 表示使用全部硬件线程
+    int iterations = 8000;          // 每次决策所有线程合计的迭代数 (timeBudgetMs > 0 时不使用)
+    int timeBudgetMs = 0;           // 每次决策的墙钟时间预算 (毫秒)，0 表示按迭代次数
+    int determinizations = 8;       // 根并行：每个线程的抽样局面数；树并行：共享树的棵数
+    double exploration = 1.4;       // UCT 探索系数
+    int virtualLoss = 3;            // 树并行：选中一个节点时预先记入的失败次数
+    int nodeCapacity = 1 << 20;     // 节点容量 (树并行为共享池，根并行为每个线程的竞技场)，用满后不再扩展
+    RolloutPolicy rollout = ROLLOUT_GREEDY;
+    uint64_t seed = 1;
+};
+
+class ParallelMCTSStrategy : public SearchStrategy {
+public:
+    explicit ParallelMCTSStrategy(ParallelMCTSConfig config = {});
+
+    Action makeDecision(const GameView& view) override;
+
+    /**
+     * @brief 在 snapshot 上并行搜索，把根节点各行动的访问次数累加到 visits
+     * @return 所有线程合计完成的模拟次数
+     */
+    long searchRoot(const GameState& snapshot, std::vector<int>& visits);
+
+    int threadCount() const;
+
+private:
+    /**
+     * @struct SharedNode
+     * @brief 共享树的节点
+     * state: 0 = 未扩展, 1 = 某个线程正在扩展, 2 = 已扩展。
+     * 子节点在扩展时从节点池中一次性领取一段连续的位置。
+     */
+    struct SharedNode {
+        MCTSMove move;
+        uint8_t mover;
+        std::atomic<uint8_t> state;
+        int firstChild;
+        int childCount;
+        std::atomic<int> visits;
+        std::atomic<int> wins;
+    };
+
+    ParallelMCTSConfig config;
+    Rng rng;
+    std::vector<std::unique_ptr<MCTSStrategy>> workers;    // 根并行的各线程搜索器
+    std::unique_ptr<SharedNode[]> pool;     // 树并行的节点池，首次使用时分配
+    std::atomic<int> poolUsed{0};
+
+    long searchRootParallel(const GameState& snapshot, std::vector<int>& visits);
+    long searchTreeParallel(const GameState& snapshot, std::vector<int>& visits);
+    // 从节点池领取 count 个连续节点，池已用满时返回 -1
+    int allocate(int count);
+    int selectChild(const SharedNode& parent) const;
+    bool expand(int nodeIdx, const GameState& s);
+    void iterate(int rootIdx, const GameState& root, Rng& rng);
+};
+
+#endif
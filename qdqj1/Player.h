@@ -9,10 +9,10 @@
 #define PLAYER_H
 
 #include "Structs.h"
+#include <bit>
+#include <cstdint>
 #include <string>
 #include <vector>
-#include <map>
-#include <set>
 
 /**
  * @class Player
@@ -26,54 +26,52 @@ struct Player {
 
     /**
      * @brief 资源产量统计
-     * 键(Key): 资源类型 (WOOD, CLAY...)
-     * 值(Value): 每回合自动产出的数量
+     * 下标: 资源类型 (WOOD, CLAY...)
+     * 值: 每回合自动产出的数量
      * 作用：用于计算购买卡牌时的基础资源是否足够。
      */
-    std::map<Resource, int> production;
+    uint8_t production[5] = {};
 
     /**
      * @brief 科技符号统计
-     * 键(Key): 科技符号类型 (GLOBE, TABLET...)
-     * 值(Value): 拥有的数量
+     * 下标: 科技符号类型 (GLOBE, TABLET...)，不含 NO_SYMBOL
+     * 值: 拥有的数量 (兑换过科技币的符号记为 3)
      * 作用：用于判断科技胜利(集齐6种)和获得科技币(集齐一对)。
      */
-    std::map<ScienceSymbol, int> scienceSymbols;
+    uint8_t scienceSymbols[6] = {};
 
     /**
      * @brief 连锁符号集合
-     * 存储玩家目前拥有的所有连锁符号。
-     * 使用 set 是为了快速查找是否存在某个符号 (O(logN) 复杂度)。
+     * 位掩码：第 c 位表示拥有连锁符号 c，查询只需一次位运算。
      * 作用：判断是否满足下一张卡的连锁免费条件。
      */
-    std::set<ChainSymbol> chainIcons;
+    uint32_t chainIcons = 0;
 
     /**
      * @brief 拥有的奇迹列表
-     * 存储分配给该玩家的 4 个奇迹。
+     * 存储分配给该玩家的 4 个奇迹 (奇迹编号 + 是否建成)。
      */
-    std::vector<Wonder> wonders;
+    std::vector<WonderSlot> wonders;
 
     /**
      * @brief 已建造的所有卡牌
-     * 存储玩家已经建造好的卡牌对象。
+     * 存储玩家已经建造好的卡牌编号 (卡牌属性通过 CardDatabase::getCard 查询)。
      * 作用：用于游戏结束时的公会算分，或某些奇迹(摧毁卡牌)的目标查找。
      */
-    std::vector<Card> builtCards;
+    std::vector<int> builtCards;
 
     /**
      * @brief 拥有的科技进步指示物
-     * 存储玩家获得的绿色科技币。
+     * 位掩码：第 t 位表示拥有科技币 t。
      */
-    std::vector<ProgressToken> tokens;
+    uint16_t tokens = 0;
 
     /**
      * @brief 贸易固定价格开关
-     * 键(Key): 资源类型
-     * 值(Value): 是否固定为 1 金币
+     * 位掩码：第 r 位表示资源 r 的买入价固定为 1 金币
      * 作用：如果有黄色贸易卡(如木材储备)，对应的资源买入价锁定为 1，无视对手产量。
      */
-    std::map<Resource, bool> tradeFixed;
+    uint8_t tradeFixed = 0;
 
     /**
      * @brief 构造函数
@@ -87,14 +85,14 @@ struct Player {
      * 作用：用于计算弃牌收益 (收益 = 2 + 黄卡数)。
      * @return 黄色卡牌的数量
      */
-    int getYellowCount();
+    int getYellowCount() const;
 
     /**
      * @brief 获取已建成的奇迹数量
      * 作用：用于某些公会卡(如建筑师公会)的计分。
      * @return 已建成(built=true)的奇迹数量
      */
-    int getWonderCount();
+    int getWonderCount() const;
 
     /**
      * @brief 统计拥有的不同科技符号种类数
@@ -102,14 +100,26 @@ struct Player {
      * 特殊逻辑：如果拥有“法律”(P_LAW)科技币，返回值会在实际种类上 +1。
      * @return 不同符号的种类数量
      */
-    int countScienceDistinct();
+    int countScienceDistinct() const;
 
     /**
      * @brief 检查是否拥有特定的科技币
      * @param t 要检查的科技币类型
      * @return 如果拥有则返回 true，否则返回 false
      */
-    bool hasToken(ProgressToken t);
+    bool hasToken(ProgressToken t) const { return (tokens >> t) & 1; }
+
+    // 获得一枚科技币
+    void addToken(ProgressToken t) { tokens |= 1 << t; }
+
+    // 拥有的科技币数量 (数学科技币计分使用)
+    int tokenCount() const { return std::popcount(tokens); }
+
+    // 是否拥有某个连锁符号
+    bool hasChain(ChainSymbol c) const { return (chainIcons >> c) & 1; }
+
+    // 某种资源的买入价是否固定为 1 金币
+    bool hasTradeFixed(Resource r) const { return (tradeFixed >> r) & 1; }
 };
 
 #endif
\ No newline at end of file
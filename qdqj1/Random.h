@@ -0,0 +1,84 @@
+/**
+ * @file Random.h
+ * @brief 可复现的随机数生成器
+ * 作用：整局游戏中的所有洗牌、抽取都通过同一个可指定种子的生成器完成，
+ *      给定相同的种子即可完整复现一局对局，也方便多线程分片模拟。
+ */
+
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <cstdint>
+#include <limits>
+
+/**
+ * @class Rng
+ * @brief xoshiro256** 随机数生成器
+ * 状态只有 32 字节且是平凡类型 (可直接放进 GameState 中 memcpy)，
+ * 满足 UniformRandomBitGenerator 要求。
+ * 洗牌使用自带的 shuffle()，不依赖 std::shuffle 在不同标准库中的实现差异。
+ */
+class Rng {
+public:
+    using result_type = uint64_t;
+
+    Rng() = default;
+    explicit Rng(uint64_t seed) { reseed(seed); }
+
+    /**
+     * @brief 重新设置种子
+     * 使用 splitmix64 把 64 位种子扩展为 256 位内部状态。
+     */
+    void reseed(uint64_t seed) {
+        for (auto& word : s) {
+            seed += 0x9E3779B97F4A7C15ull;
+            uint64_t z = seed;
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+            word = z ^ (z >> 31);
+        }
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    result_type operator()() {
+        const uint64_t result = rotl(s[1] * 5, 7) * 9;
+        const uint64_t t = s[1] << 17;
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = rotl(s[3], 45);
+        return result;
+    }
+
+    /**
+     * @brief 返回 [0, n) 内的均匀随机整数 (n > 0)
+     * 使用乘法取高位，避免取模带来的偏差和除法开销。
+     */
+    int below(int n) {
+        return (int)(((unsigned __int128)(*this)() * (uint64_t)n) >> 64);
+    }
+
+    /**
+     * @brief Fisher-Yates 洗牌
+     */
+    template <typename It>
+    void shuffle(It first, It last) {
+        for (auto n = last - first; n > 1; n--) {
+            int j = below((int)n);
+            auto tmp = first[n - 1];
+            first[n - 1] = first[j];
+            first[j] = tmp;
+        }
+    }
+
+private:
+    uint64_t s[4];
+
+    static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+};
+
+#endif
@@ -0,0 +1,216 @@
+/**
+ * @file Replay.cpp
+ * @brief 对局记录的编码、解码与重放
+ */
+
+#include "Replay.h"
+#include "Game.h"
+#include "GameView.h"
+#include <bit>
+#include <cstdio>
+#include <cstring>
+
+using namespace std;
+
+static const char MAGIC[4] = {'7', 'W', 'D', 'R'};
+
+/**
+ * @class RecordingStrategy
+ * @brief 把选择转交内部策略，并把结果记到共享的记录器上
+ */
+class RecordingStrategy : public PlayerStrategy {
+public:
+    RecordingStrategy(shared_ptr<ReplayRecorder> recorder, unique_ptr<PlayerStrategy> inner)
+        : recorder(std::move(recorder)), inner(std::move(inner)) {}
+
+    Action makeDecision(const GameView& view) override {
+        Action a = inner->makeDecision(view);
+        recorder->recordMove(a);
+        return a;
+    }
+    int chooseWonder(const vector<int>& options, const GameView& view) override {
+        int choice = inner->chooseWonder(options, view);
+        recorder->recordDraft(choice);
+        return choice;
+    }
+    int chooseCardFromDiscard(const vector<int>& pile, const GameView& view) override {
+        int choice = inner->chooseCardFromDiscard(pile, view);
+        recorder->recordChoice(choice, pile.size());
+        return choice;
+    }
+    int chooseCardToDestroy(const vector<int>& targets, const GameView& view) override {
+        int choice = inner->chooseCardToDestroy(targets, view);
+        recorder->recordChoice(choice, targets.size());
+        return choice;
+    }
+    int chooseToken(const vector<ProgressToken>& options, const GameView& view) override {
+        int choice = inner->chooseToken(options, view);
+        recorder->recordChoice(choice, options.size());
+        return choice;
+    }
+
+private:
+    shared_ptr<ReplayRecorder> recorder;
+    unique_ptr<PlayerStrategy> inner;
+};
+
+/**
+ * @class PlaybackStrategy
+ * @brief 按记录下棋，双方共用一个读取位置
+ */
+class PlaybackStrategy : public PlayerStrategy {
+public:
+    struct Cursor {
+        const ReplayRecord* record;
+        size_t next = 0;
+        int draftPicks = 0;
+    };
+
+    explicit PlaybackStrategy(shared_ptr<Cursor> cursor) : cursor(std::move(cursor)) {}
+
+    Action makeDecision(const GameView& view) override {
+        span<const uint8_t> stream = cursor->record->stream;
+        // 记录已读完或错位时弃掉第一张可拿的牌，保证对局能结束
+        if (cursor->next >= stream.size() || stream[cursor->next] >= ReplayRecord::CHOICE_FLAG) {
+            return {2, countr_zero(view.availableMask()), -1};
+        }
+        return decodeAction(stream[cursor->next++]);
+    }
+    int chooseWonder(const vector<int>& options, const GameView& view) override {
+        return (cursor->record->draft >> (2 * cursor->draftPicks++)) & 3;
+    }
+    int chooseCardFromDiscard(const vector<int>& pile, const GameView& view) override { return nextChoice(); }
+    int chooseCardToDestroy(const vector<int>& targets, const GameView& view) override { return nextChoice(); }
+    int chooseToken(const vector<ProgressToken>& options, const GameView& view) override { return nextChoice(); }
+
+private:
+    shared_ptr<Cursor> cursor;
+
+    int nextChoice() {
+        span<const uint8_t> stream = cursor->record->stream;
+        if (cursor->next >= stream.size() || stream[cursor->next] < ReplayRecord::CHOICE_FLAG) return -1;
+        uint8_t b = stream[cursor->next++];
+        return b == ReplayRecord::NO_CHOICE ? -1 : b & 0x7F;
+    }
+};
+
+// --- ReplayRecord ---
+
+int ReplayRecord::moveCount() const {
+    int n = 0;
+    for (uint8_t b : stream) n += b < CHOICE_FLAG;
+    return n;
+}
+
+size_t ReplayRecord::parse(span<const uint8_t> data, ReplayRecord& out) {
+    if (data.empty()) return 0;
+    size_t len = data[0];
+    if (len < FIXED_BYTES || data.size() < 1 + len) return 0;
+    const uint8_t* p = data.data() + 1;
+    out.seed = 0;
+    for (int i = 0; i < 8; i++) out.seed |= (uint64_t)p[i] << (8 * i);
+    out.strategies[0] = p[8] & 0xF;
+    out.strategies[1] = p[8] >> 4;
+    out.draft = (uint16_t)(p[9] | p[10] << 8);
+    out.stream = data.subspan(1 + FIXED_BYTES, len - FIXED_BYTES);
+    return 1 + len;
+}
+
+GameResult ReplayRecord::replay(GameState* finalState, GameState* startState) const {
+    auto cursor = make_shared<PlaybackStrategy::Cursor>();
+    cursor->record = this;
+    Game game("P1", make_unique<PlaybackStrategy>(cursor), "P2", make_unique<PlaybackStrategy>(cursor), seed, true);
+    if (startState) *startState = game.snapshot();
+    GameResult r = game.simulate();
+    if (finalState) *finalState = game.snapshot();
+    return r;
+}
+
+// --- ReplayRecorder ---
+
+ReplayRecorder::ReplayRecorder(uint64_t seed, int strategyP1, int strategyP2)
+    : seed(seed), strategies((uint8_t)((strategyP1 & 0xF) | (strategyP2 & 0xF) << 4)) {
+    stream.reserve(96);
+}
+
+unique_ptr<PlayerStrategy> ReplayRecorder::wrap(shared_ptr<ReplayRecorder> recorder, unique_ptr<PlayerStrategy> inner) {
+    return make_unique<RecordingStrategy>(std::move(recorder), std::move(inner));
+}
+
+void ReplayRecorder::recordDraft(int choice) {
+    draft |= (uint16_t)((choice & 3) << (2 * draftPicks++));
+}
+
+void ReplayRecorder::recordMove(const Action& action) {
+    stream.push_back(encodeAction(action));
+}
+
+void ReplayRecorder::recordChoice(int choice, size_t optionCount) {
+    bool valid = choice >= 0 && (size_t)choice < optionCount && choice < 0x7F;
+    stream.push_back(valid ? (uint8_t)(ReplayRecord::CHOICE_FLAG | choice) : ReplayRecord::NO_CHOICE);
+}
+
+void ReplayRecorder::append(vector<uint8_t>& out) const {
+    out.push_back((uint8_t)(ReplayRecord::FIXED_BYTES + stream.size()));
+    for (int i = 0; i < 8; i++) out.push_back((uint8_t)(seed >> (8 * i)));
+    out.push_back(strategies);
+    out.push_back((uint8_t)draft);
+    out.push_back((uint8_t)(draft >> 8));
+    out.insert(out.end(), stream.begin(), stream.end());
+}
+
+// --- ReplayFile ---
+
+size_t ReplayFile::parseHeader(span<const uint8_t> data, vector<string>& strategies) {
+    if (data.size() < 6 || memcmp(data.data(), MAGIC, 4) != 0 || data[4] != VERSION) return 0;
+    strategies.clear();
+    size_t pos = 6;
+    for (int i = 0; i < data[5]; i++) {
+        if (pos >= data.size() || pos + 1 + data[pos] > data.size()) return 0;
+        strategies.emplace_back((const char*)data.data() + pos + 1, data[pos]);
+        pos += 1 + data[pos];
+    }
+    return pos;
+}
+
+void ReplayFile::appendHeader(const vector<string>& strategies, vector<uint8_t>& out) {
+    out.insert(out.end(), MAGIC, MAGIC + 4);
+    out.push_back(VERSION);
+    out.push_back((uint8_t)strategies.size());
+    for (const string& s : strategies) {
+        size_t len = min<size_t>(s.size(), 255);
+        out.push_back((uint8_t)len);
+        out.insert(out.end(), s.begin(), s.begin() + len);
+    }
+}
+
+bool ReplayFile::save(const string& path) const {
+    vector<uint8_t> header;
+    appendHeader(strategies, header);
+    FILE* f = fopen(path.c_str(), "wb");
+    if (!f) return false;
+    bool ok = fwrite(header.data(), 1, header.size(), f) == header.size()
+           && fwrite(records.data(), 1, records.size(), f) == records.size();
+    return fclose(f) == 0 && ok;
+}
+
+bool ReplayFile::load(const string& path) {
+    FILE* f = fopen(path.c_str(), "rb");
+    if (!f) return false;
+    vector<uint8_t> data;
+    uint8_t buf[1 << 16];
+    for (size_t n; (n = fread(buf, 1, sizeof(buf), f)) > 0; ) data.insert(data.end(), buf, buf + n);
+    fclose(f);
+    size_t header = parseHeader(data, strategies);
+    if (header == 0) return false;
+    records.assign(data.begin() + header, data.end());
+    return true;
+}
+
+vector<ReplayRecord> ReplayFile::parseRecords() const {
+    vector<ReplayRecord> out;
+    span<const uint8_t> rest = records;
+    ReplayRecord r;
+    for (size_t n; (n = ReplayRecord::parse(rest, r)) > 0; rest = rest.subspan(n)) out.push_back(r);
+    return out;
+}
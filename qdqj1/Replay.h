@@ -0,0 +1,120 @@
+/**
+ * @file Replay.h
+ * @brief 紧凑的二进制对局记录
+ * 作用：把每一局压成一条几十字节的记录，便于长期保存大量对局以供分析。
+ *      Game 的随机源只用于洗科技币、发奇迹、发牌和大图书馆的抽取，策略各自使用自己的随机源，
+ *      因此一局完全由种子和双方的选择决定：记录只保存种子、奇迹轮抽和行动流，
+ *      发到的牌 (以及大图书馆抽到的科技币) 由重放得到，不单独存储。
+ *
+ * 文件格式 (整数均为小端)：
+ *   文件头：魔数 "7WDR"、版本 (1 字节)、策略数 n (1 字节)，然后是 n 个策略名 (长度 1 字节 + 字符)
+ *   之后是任意多条对局记录，每条为：
+ *     长度 L (1 字节，不含自身)
+ *     种子 (8 字节)
+ *     策略 (1 字节：低 4 位为玩家1、高 4 位为玩家2 在策略表中的下标)
+ *     奇迹轮抽 (2 字节：有选择的 6 次轮抽，每次 2 位，从低位起按轮抽顺序排列)
+ *     行动流 (L - 11 字节)：小于 0x80 的字节是一次行动 (encodeAction)；
+ *       0x80 | i 是上一次行动引出的附带选择 (陵墓 / 宙斯神像 / 竞技场 / 大图书馆，选项下标 i)，
+ *       0xFF 表示附带选择返回了越界的下标 (放弃选择)。
+ *   一局通常 60 次左右行动，整条记录约 75 字节。
+ */
+
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include "Strategy.h"
+#include "GameState.h"
+#include "Structs.h"
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+/**
+ * @struct ReplayRecord
+ * @brief 一条对局记录的只读视图，行动流直接指向记录所在的缓冲区，不复制
+ */
+struct ReplayRecord {
+    static const int FIXED_BYTES = 11;  // 种子 + 策略 + 奇迹轮抽
+    static const uint8_t CHOICE_FLAG = 0x80;
+    static const uint8_t NO_CHOICE = 0xFF;
+
+    uint64_t seed = 0;
+    uint8_t strategies[2] = {};         // 双方在文件策略表中的下标
+    uint16_t draft = 0;
+    std::span<const uint8_t> stream;
+
+    // 行动次数 (不含附带选择)，与 GameResult::moveCount 相同
+    int moveCount() const;
+
+    /**
+     * @brief 从 data 开头解析一条记录
+     * @return 这条记录占用的总字节数 (含长度字节)，数据不完整时返回 0
+     */
+    static size_t parse(std::span<const uint8_t> data, ReplayRecord& out);
+
+    /**
+     * @brief 按记录重放整局
+     * @param finalState 不为空时写入终局的快照 (含最后一个时代发到的牌)
+     * @param startState 不为空时写入奇迹轮抽结束、第一时代发牌后的快照
+     */
+    GameResult replay(GameState* finalState = nullptr, GameState* startState = nullptr) const;
+};
+
+/**
+ * @class ReplayRecorder
+ * @brief 在对局进行中生成一条记录
+ * 用 wrap() 把双方的策略包在同一个记录器上，包装后的策略把每个选择转交内部策略，
+ * 再按发生顺序记下结果。对局结束后用 append() 取出编码好的记录。
+ */
+class ReplayRecorder {
+public:
+    /**
+     * @param strategyP1 / strategyP2 双方在文件策略表中的下标 (0~15)
+     */
+    ReplayRecorder(uint64_t seed, int strategyP1, int strategyP2);
+
+    static std::unique_ptr<PlayerStrategy> wrap(std::shared_ptr<ReplayRecorder> recorder, std::unique_ptr<PlayerStrategy> inner);
+
+    void recordDraft(int choice);
+    void recordMove(const Action& action);
+    void recordChoice(int choice, size_t optionCount);
+
+    // 把编码好的记录 (含长度字节) 追加到 out
+    void append(std::vector<uint8_t>& out) const;
+
+private:
+    uint64_t seed;
+    uint8_t strategies;
+    uint16_t draft = 0;
+    int draftPicks = 0;
+    std::vector<uint8_t> stream;
+};
+
+/**
+ * @class ReplayFile
+ * @brief 整个读入内存的记录文件：策略表加上依次排列的记录
+ */
+class ReplayFile {
+public:
+    static constexpr uint8_t VERSION = 1;
+
+    std::vector<std::string> strategies;
+    std::vector<uint8_t> records;   // 文件头之后的全部记录，按 ReplayRecorder::append 的格式首尾相接
+
+    /**
+     * @brief 解析文件头
+     * @return 文件头的字节数，魔数或版本不符、数据不完整时返回 0
+     */
+    static size_t parseHeader(std::span<const uint8_t> data, std::vector<std::string>& strategies);
+    static void appendHeader(const std::vector<std::string>& strategies, std::vector<uint8_t>& out);
+
+    bool save(const std::string& path) const;
+    bool load(const std::string& path);
+
+    // 依次解析全部记录；遇到不完整的记录时停止
+    std::vector<ReplayRecord> parseRecords() const;
+};
+
+#endif
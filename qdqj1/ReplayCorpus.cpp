@@ -0,0 +1,289 @@
+/**
+ * @file ReplayCorpus.cpp
+ * @brief 对局语料库的写入与内存映射读取
+ */
+
+#include "ReplayCorpus.h"
+#include "CardDatabase.h"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <thread>
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define REPLAY_CORPUS_MMAP
+#endif
+
+using namespace std;
+
+static_assert(endian::native == endian::little, "语料库按小端直接映射各列");
+
+static const char SEGMENT_MAGIC[4] = {'7', 'W', 'D', 'S'};
+
+/**
+ * @struct SegmentLayout
+ * @brief 一段中各节相对段头的偏移
+ */
+struct SegmentLayout {
+    size_t strategies, offsets, winner, victory, scores[2], picked[2], built[2], guilds, moves, records, end;
+};
+
+static SegmentLayout layoutOf(uint32_t n, uint32_t strategyBytes, uint64_t recordBytes) {
+    SegmentLayout l;
+    size_t pos = sizeof(CorpusSegmentHeader);
+    auto take = [&](size_t bytes) {
+        size_t at = pos;
+        pos = (pos + bytes + 7) & ~(size_t)7;
+        return at;
+    };
+    l.strategies = take(strategyBytes);
+    l.offsets = take(4 * ((size_t)n + 1));
+    l.winner = take(n);
+    l.victory = take(n);
+    for (auto& c : l.scores) c = take(2 * (size_t)n);
+    for (auto& c : l.picked) c = take(2 * (size_t)n);
+    for (auto& c : l.built) c = take(2 * (size_t)n);
+    l.guilds = take(n);
+    l.moves = take(n);
+    l.records = take(recordBytes);
+    l.end = pos;
+    return l;
+}
+
+// --- ReplaySummary ---
+
+ReplaySummary ReplaySummary::of(const ReplayRecord& record) {
+    GameState start, final;
+    GameResult r = record.replay(&final, &start);
+    ReplaySummary s;
+    s.winner = (int8_t)r.winner;
+    s.victory = (uint8_t)r.victory;
+    for (int p = 0; p < 2; p++) {
+        s.scores[p] = (int16_t)r.scores[p];
+        const PlayerState& first = start.players[p];
+        for (int w = 0; w < first.wonderCount; w++) s.wondersPicked[p] |= 1u << first.wonders[w];
+        // 第 7 个奇迹建成后未建成的奇迹被移除，终局的奇迹列表只剩建成的
+        const PlayerState& last = final.players[p];
+        for (int w = 0; w < last.wonderCount; w++) {
+            if ((last.wondersBuilt >> w) & 1) s.wondersBuilt[p] |= 1u << last.wonders[w];
+        }
+    }
+    if (final.age == 3) {
+        for (int i = 0; i < 20; i++) {
+            const Card& c = CardDatabase::getCard(final.slotCard[i]);
+            if (c.type == GUILD) s.guilds |= 1u << (c.guildType - 1);
+        }
+    }
+    s.moves = (uint8_t)min(r.moveCount, 255);
+    return s;
+}
+
+// --- ReplayCorpus::Segment ---
+
+ReplayRecord ReplayCorpus::Segment::record(uint32_t i) const {
+    ReplayRecord r;
+    ReplayRecord::parse({records + offsets[i], offsets[i + 1] - offsets[i]}, r);
+    return r;
+}
+
+ReplaySummary ReplayCorpus::Segment::summary(uint32_t i) const {
+    ReplaySummary s;
+    s.winner = winner[i];
+    s.victory = victory[i];
+    for (int p = 0; p < 2; p++) {
+        s.scores[p] = scores[p][i];
+        s.wondersPicked[p] = wondersPicked[p][i];
+        s.wondersBuilt[p] = wondersBuilt[p][i];
+    }
+    s.guilds = guilds[i];
+    s.moves = moves[i];
+    return s;
+}
+
+// --- ReplayCorpus ---
+
+ReplayCorpus::~ReplayCorpus() { close(); }
+
+void ReplayCorpus::close() {
+#ifdef REPLAY_CORPUS_MMAP
+    if (mapped) munmap((void*)base, size);
+#endif
+    base = nullptr;
+    size = 0;
+    valid = 0;
+    mapped = false;
+    buffer.clear();
+    segs.clear();
+    games = 0;
+}
+
+bool ReplayCorpus::open(const string& path) {
+    close();
+#ifdef REPLAY_CORPUS_MMAP
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0) { ::close(fd); return false; }
+    size = (size_t)st.st_size;
+    if (size > 0) {
+        void* p = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+        if (p == MAP_FAILED) { ::close(fd); size = 0; return false; }
+        base = (const uint8_t*)p;
+        mapped = true;
+    }
+    ::close(fd);
+#else
+    FILE* f = fopen(path.c_str(), "rb");
+    if (!f) return false;
+    uint8_t chunk[1 << 16];
+    for (size_t n; (n = fread(chunk, 1, sizeof(chunk), f)) > 0; ) buffer.insert(buffer.end(), chunk, chunk + n);
+    fclose(f);
+    base = buffer.data();
+    size = buffer.size();
+#endif
+
+    // 逐段解析；写到一半的末段 (或损坏的段) 及其之后的内容被忽略
+    size_t pos = 0;
+    while (pos + sizeof(CorpusSegmentHeader) <= size) {
+        CorpusSegmentHeader h;
+        memcpy(&h, base + pos, sizeof h);
+        if (memcmp(h.magic, SEGMENT_MAGIC, 4) != 0 || h.version != VERSION) break;
+        if (h.segmentBytes > size - pos) break;
+        SegmentLayout l = layoutOf(h.gameCount, h.strategyBytes, h.recordBytes);
+        if (l.end != h.segmentBytes) break;
+
+        const uint8_t* seg = base + pos;
+        Segment s;
+        if (ReplayFile::parseHeader({seg + l.strategies, h.strategyBytes}, s.strategies) == 0) break;
+        s.firstGame = games;
+        s.gameCount = h.gameCount;
+        s.offsets = (const uint32_t*)(seg + l.offsets);
+        s.winner = (const int8_t*)(seg + l.winner);
+        s.victory = seg + l.victory;
+        for (int p = 0; p < 2; p++) {
+            s.scores[p] = (const int16_t*)(seg + l.scores[p]);
+            s.wondersPicked[p] = (const uint16_t*)(seg + l.picked[p]);
+            s.wondersBuilt[p] = (const uint16_t*)(seg + l.built[p]);
+        }
+        s.guilds = seg + l.guilds;
+        s.moves = seg + l.moves;
+        s.records = seg + l.records;
+        // 偏移必须单调不减并以 recordBytes 结尾，否则 record() 会越过记录区读取
+        bool offsetsOk = s.offsets[0] == 0 && s.offsets[h.gameCount] == h.recordBytes;
+        for (uint32_t i = 0; offsetsOk && i < h.gameCount; i++) offsetsOk = s.offsets[i] <= s.offsets[i + 1];
+        if (!offsetsOk) break;
+        segs.push_back(std::move(s));
+        games += h.gameCount;
+        pos += h.segmentBytes;
+    }
+    valid = pos;
+    return true;
+}
+
+const ReplayCorpus::Segment* ReplayCorpus::segmentOf(uint64_t game) const {
+    if (game >= games) return nullptr;
+    auto it = upper_bound(segs.begin(), segs.end(), game, [](uint64_t g, const Segment& s) { return g < s.firstGame; });
+    return &*(it - 1);
+}
+
+bool ReplayCorpus::record(uint64_t game, ReplayRecord& out) const {
+    const Segment* s = segmentOf(game);
+    if (!s) return false;
+    out = s->record((uint32_t)(game - s->firstGame));
+    return true;
+}
+
+bool ReplayCorpus::summary(uint64_t game, ReplaySummary& out) const {
+    const Segment* s = segmentOf(game);
+    if (!s) return false;
+    out = s->summary((uint32_t)(game - s->firstGame));
+    return true;
+}
+
+bool ReplayCorpus::truncateTornTail(const string& path) {
+    error_code ec;
+    if (!filesystem::exists(path, ec)) return true;
+    ReplayCorpus existing;
+    if (!existing.open(path)) return false;
+    size_t valid = existing.valid, size = existing.size;
+    if (valid == size) return true;
+    // 有效段之后的内容以段魔数 (或它的前缀) 开头才是中断的追加，否则不是语料库文件
+    bool torn = memcmp(existing.base + valid, SEGMENT_MAGIC, min<size_t>(4, size - valid)) == 0;
+    existing.close();
+    if (!torn) return false;
+    filesystem::resize_file(path, valid, ec);
+    return !ec;
+}
+
+bool ReplayCorpus::append(const string& path, const ReplayFile& file, int threads) {
+    vector<ReplayRecord> records = file.parseRecords();
+
+    // 重放得到摘要：每个线程循环领取下一局
+    vector<ReplaySummary> summaries(records.size());
+    atomic<size_t> next{0};
+    auto worker = [&] {
+        for (size_t i; (i = next.fetch_add(1, memory_order_relaxed)) < records.size(); ) {
+            summaries[i] = ReplaySummary::of(records[i]);
+        }
+    };
+    vector<thread> pool;
+    for (int t = 0; t < max(1, threads); t++) pool.emplace_back(worker);
+    for (auto& th : pool) th.join();
+
+    vector<uint8_t> strategyTable;
+    ReplayFile::appendHeader(file.strategies, strategyTable);
+
+    if (!truncateTornTail(path)) return false;
+    FILE* f = fopen(path.c_str(), "ab");
+    if (!f) return false;
+    bool ok = true;
+    vector<uint8_t> seg;
+    for (size_t first = 0; ok && first < records.size(); first += MAX_SEGMENT_GAMES) {
+        uint32_t n = (uint32_t)min<size_t>(MAX_SEGMENT_GAMES, records.size() - first);
+        uint64_t recordBytes = 0;
+        for (uint32_t i = 0; i < n; i++) recordBytes += 1 + ReplayRecord::FIXED_BYTES + records[first + i].stream.size();
+        SegmentLayout l = layoutOf(n, (uint32_t)strategyTable.size(), recordBytes);
+
+        seg.assign(l.end, 0);
+        CorpusSegmentHeader h;
+        memcpy(h.magic, SEGMENT_MAGIC, 4);
+        h.version = VERSION;
+        h.segmentBytes = l.end;
+        h.gameCount = n;
+        h.strategyBytes = (uint32_t)strategyTable.size();
+        h.recordBytes = recordBytes;
+        memcpy(seg.data(), &h, sizeof h);
+        memcpy(seg.data() + l.strategies, strategyTable.data(), strategyTable.size());
+
+        uint8_t* out = seg.data();
+        uint32_t offset = 0;
+        for (uint32_t i = 0; i < n; i++) {
+            const ReplayRecord& r = records[first + i];
+            const ReplaySummary& s = summaries[first + i];
+            // 记录按原样复制：长度字节 + 固定部分 + 行动流 在记录文件中是连续的
+            const uint8_t* src = r.stream.data() - ReplayRecord::FIXED_BYTES - 1;
+            size_t len = 1 + ReplayRecord::FIXED_BYTES + r.stream.size();
+            memcpy(out + l.records + offset, src, len);
+            memcpy(out + l.offsets + 4 * i, &offset, 4);
+            offset += (uint32_t)len;
+            out[l.winner + i] = (uint8_t)s.winner;
+            out[l.victory + i] = s.victory;
+            for (int p = 0; p < 2; p++) {
+                memcpy(out + l.scores[p] + 2 * i, &s.scores[p], 2);
+                memcpy(out + l.picked[p] + 2 * i, &s.wondersPicked[p], 2);
+                memcpy(out + l.built[p] + 2 * i, &s.wondersBuilt[p], 2);
+            }
+            out[l.guilds + i] = s.guilds;
+            out[l.moves + i] = s.moves;
+        }
+        memcpy(out + l.offsets + 4 * (size_t)n, &offset, 4);
+        ok = fwrite(seg.data(), 1, seg.size(), f) == seg.size();
+    }
+    return fclose(f) == 0 && ok;
+}
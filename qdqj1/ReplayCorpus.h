@@ -0,0 +1,126 @@
+/**
+ * @file ReplayCorpus.h
+ * @brief 可内存映射的对局语料库
+ * 作用：把大量对局记录 (见 Replay.h) 归档到一个只追加的文件里，读取方 mmap 整个文件，
+ *      不复制任何数据就能按编号随机访问任意一局，或者按摘要列并行扫描筛选。
+ *
+ * 文件由若干段首尾相接组成，每次追加写入一个完整的段，已有的段从不改写；
+ * 末尾写到一半的段 (长度不足) 在打开时被忽略，下一次追加前被截掉。一段的布局 (小端，每一节按 8 字节对齐)：
+ *   段头 CorpusSegmentHeader (32 字节)
+ *   策略表：与记录文件的文件头相同 (ReplayFile::appendHeader)
+ *   偏移索引：uint32[n + 1]，第 i 局的记录位于记录区 [offsets[i], offsets[i + 1])；
+ *     打开时检查它从 0 单调不减到记录区长度，不满足的段按损坏处理 (连同之后的内容被忽略)
+ *   摘要列 (每列 n 个元素，列式存放，筛选时只读用到的列)：
+ *     winner int8 | victory uint8 | score0 int16 | score1 int16 |
+ *     picked0 uint16 | picked1 uint16 | built0 uint16 | built1 uint16 | guilds uint8 | moves uint8
+ *   记录区：按 ReplayRecorder::append 的格式首尾相接的记录
+ */
+
+#ifndef REPLAYCORPUS_H
+#define REPLAYCORPUS_H
+
+#include "Replay.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @struct ReplaySummary
+ * @brief 一局的摘要，即语料库中一行摘要列的内容
+ */
+struct ReplaySummary {
+    int8_t winner = -1;             // 0 = 玩家1, 1 = 玩家2
+    uint8_t victory = V_NONE;       // VictoryType
+    int16_t scores[2] = {};
+    uint16_t wondersPicked[2] = {}; // 轮抽到的奇迹，第 i 位 = WonderId i
+    uint16_t wondersBuilt[2] = {};  // 建成的奇迹
+    uint8_t guilds = 0;             // 第三时代版图上发到的公会卡，第 i 位 = GuildType i + 1
+    uint8_t moves = 0;              // 行动次数
+
+    // 重放记录得到摘要
+    static ReplaySummary of(const ReplayRecord& record);
+};
+
+/**
+ * @struct CorpusSegmentHeader
+ * @brief 段头，各节的位置都由 gameCount 与 strategyBytes 推出
+ */
+struct CorpusSegmentHeader {
+    char magic[4];              // "7WDS"
+    uint32_t version;
+    uint64_t segmentBytes;      // 整段的字节数 (含段头)
+    uint32_t gameCount;
+    uint32_t strategyBytes;     // 策略表的字节数
+    uint64_t recordBytes;       // 记录区的字节数
+};
+static_assert(sizeof(CorpusSegmentHeader) == 32, "段头必须是 32 字节");
+
+/**
+ * @class ReplayCorpus
+ * @brief 只读打开的语料库，段内的各列都是指向映射内存的指针
+ */
+class ReplayCorpus {
+public:
+    static const uint32_t VERSION = 1;
+    static const uint32_t MAX_SEGMENT_GAMES = 1u << 20;
+
+    struct Segment {
+        std::vector<std::string> strategies;
+        uint64_t firstGame;     // 本段第一局在整个语料库中的编号
+        uint32_t gameCount;
+        const uint32_t* offsets;
+        const int8_t* winner;
+        const uint8_t* victory;
+        const int16_t* scores[2];
+        const uint16_t* wondersPicked[2];
+        const uint16_t* wondersBuilt[2];
+        const uint8_t* guilds;
+        const uint8_t* moves;
+        const uint8_t* records;
+
+        ReplayRecord record(uint32_t i) const;
+        ReplaySummary summary(uint32_t i) const;
+    };
+
+    ReplayCorpus() = default;
+    ~ReplayCorpus();
+    ReplayCorpus(const ReplayCorpus&) = delete;
+    ReplayCorpus& operator=(const ReplayCorpus&) = delete;
+
+    bool open(const std::string& path);
+    void close();
+
+    const std::vector<Segment>& segments() const { return segs; }
+    uint64_t gameCount() const { return games; }
+    size_t mappedBytes() const { return size; }
+    // 有效段的总字节数，之后的内容 (写到一半或损坏的段) 被忽略
+    size_t validBytes() const { return valid; }
+
+    // 按全局编号随机访问 (二分查找所在的段)；编号不小于 gameCount() 时返回 nullptr / false
+    const Segment* segmentOf(uint64_t game) const;
+    bool record(uint64_t game, ReplayRecord& out) const;
+    bool summary(uint64_t game, ReplaySummary& out) const;
+
+    /**
+     * @brief 把记录文件中的全部对局追加到语料库 (文件不存在时创建)
+     * 摘要由重放得到，使用 threads 个线程；超过 MAX_SEGMENT_GAMES 局时拆成多段。
+     * 文件末尾有写到一半的段时先截到最后一个有效段的末尾，否则新段会接在无法解析的内容之后；
+     * 末尾的内容不像段头 (不是语料库文件) 时不做改动，返回 false。
+     */
+    static bool append(const std::string& path, const ReplayFile& file, int threads);
+
+private:
+    const uint8_t* base = nullptr;
+    size_t size = 0;
+    size_t valid = 0;
+    bool mapped = false;
+    std::vector<uint8_t> buffer;    // 不支持 mmap 的平台上整个读入内存
+    std::vector<Segment> segs;
+    uint64_t games = 0;
+
+    // 追加前把文件截到最后一个有效段的末尾 (见 append)
+    static bool truncateTornTail(const std::string& path);
+};
+
+#endif
@@ -0,0 +1,177 @@
+/**
+ * @file Rollout.cpp
+ * @brief 模拟走子策略的实现
+ */
+
+#include "Rollout.h"
+#include "CardDatabase.h"
+#include <climits>
+#include <cstdlib>
+
+using namespace std;
+
+static const int WIN_BONUS = 1000;      // 这一步直接获胜
+static const int DENY_BONUS = 500;      // 拿走对手下一步就能借以获胜的牌
+
+static const char* const POLICY_NAMES[ROLLOUT_POLICY_COUNT] = {
+    "random", "greedy", "epsilon", "military", "science", "chain",
+};
+
+/**
+ * @brief 挑分数最高的行动，同分时随机取一个 (蓄水池抽样，不需要额外的数组)
+ */
+template <typename Score>
+static MCTSMove pickBest(const GameState& s, const MCTSMove moves[], int n, Rng& rng, Score score) {
+    int best = 0, bestScore = INT_MIN, ties = 0;
+    for (int i = 0; i < n; i++) {
+        int v = score(s, moves[i]);
+        if (v > bestScore) { bestScore = v; best = i; ties = 1; }
+        else if (v == bestScore && rng.below(++ties) == 0) best = i;
+    }
+    return moves[best];
+}
+
+static const Card& slotCard(const GameState& s, const MCTSMove& m) {
+    return CardDatabase::getCard(s.slotCard[m.cardId]);
+}
+
+// 卡牌给 p 带来的盾牌数 (与 GameState::applyCardEffect 一致：战略学让军事卡多 1 个)
+static int cardShields(const GameState& s, int p, const Card& c) {
+    if (c.shields <= 0) return 0;
+    return c.shields + ((c.type == MILITARY && ((s.players[p].tokens >> P_STRATEGY) & 1)) ? 1 : 0);
+}
+
+static int greedyScore(const GameState& s, const MCTSMove& m) {
+    if (m.type == 3) {
+        const Wonder& w = CardDatabase::getWonder(s.players[s.activePlayer].wonders[m.wonderIdx]);
+        return 10 + w.points + 2 * w.shields + w.coins / 3 + (w.extraTurn ? 3 : 0);
+    }
+    if (m.type == 1) {
+        const Card& c = slotCard(s, m);
+        int score = 5 + c.points + 2 * c.shields + (c.science != NO_SYMBOL ? 3 : 0) + c.coinProduction / 3;
+        for (int r = WOOD; r <= PAPYRUS; r++) score += 2 * c.production[r];
+        return score;
+    }
+    return 0;
+}
+
+/**
+ * @brief 每金币胜利分：行动折合的胜利分除以实际花费
+ * 资源、金币、科技符号、公会粗略折算成分数；弃牌记 1 分，只比毫无价值的建造高。
+ */
+static int valuePerCoinScore(const GameState& s, const MCTSMove& m) {
+    if (m.type == 2) return 1;
+    int p = s.activePlayer;
+    int value, cost;
+    if (m.type == 3) {
+        const Wonder& w = CardDatabase::getWonder(s.players[p].wonders[m.wonderIdx]);
+        value = w.points + w.shields + w.coins / 3 + (w.extraTurn ? 2 : 0);
+        cost = s.calculateWonderCost(p, m.wonderIdx);
+    } else {
+        const Card& c = slotCard(s, m);
+        value = c.points + cardShields(s, p, c) + c.coinProduction / 3;
+        if (c.science != NO_SYMBOL) value += 2;
+        if (c.tradeDiscountRes != NO_RES) value += 1;
+        if (c.type == GUILD) value += 3;
+        for (int r = WOOD; r <= PAPYRUS; r++) value += c.production[r];
+        bool freeChain = c.chainCost != NONE_CHAIN && ((s.players[p].chainIcons >> c.chainCost) & 1);
+        cost = freeChain ? 0 : s.calculateCostDetails(p, c.cost).totalCost;
+    }
+    return value * 24 / (cost + 2);
+}
+
+static int militaryScore(const GameState& s, const MCTSMove& m) {
+    int p = s.activePlayer;
+    int pos = p == 0 ? s.militaryTrack : -s.militaryTrack;     // 从行动方看的军事条位置
+    const Card& c = slotCard(s, m);
+    int shields = 0;
+    if (m.type == 1) shields = cardShields(s, p, c);
+    else if (m.type == 3) shields = CardDatabase::getWonder(s.players[p].wonders[m.wonderIdx]).shields;
+    if (shields > 0 && pos + shields >= 9) return WIN_BONUS;
+
+    // 离对方首都越近、或自己越危险，盾牌越值钱 (greedyScore 已按每个盾牌 2 分计入)
+    int score = greedyScore(s, m) + shields * (abs(pos) / 2);
+    // 这个位置的牌被拿走 (无论建造、弃牌还是垫奇迹)，对手就少一张能直接军事胜利的牌
+    int oppShields = cardShields(s, 1 - p, c);
+    if (oppShields > 0 && pos - oppShields <= -9) score += DENY_BONUS;
+    return score;
+}
+
+static int scienceScore(const GameState& s, const MCTSMove& m) {
+    int p = s.activePlayer;
+    const Card& c = slotCard(s, m);
+    int score = greedyScore(s, m);
+    if (c.science == NO_SYMBOL) return score;
+    if (m.type == 1) {
+        int count = s.players[p].scienceSymbols[c.science];
+        if (count == 0) {
+            int distinct = s.countScienceDistinct(p);
+            if (distinct + 1 >= 6) return WIN_BONUS;
+            score += 2 + distinct;      // 越接近 6 种越值钱
+        } else if (count == 1 && s.availableTokenCount > 0) {
+            score += 5;                 // 凑成一对，拿一个科技币
+        }
+    }
+    if (s.players[1 - p].scienceSymbols[c.science] == 0 && s.countScienceDistinct(1 - p) >= 5) score += DENY_BONUS;
+    return score;
+}
+
+static int chainScore(const GameState& s, const MCTSMove& m) {
+    const PlayerState& me = s.players[s.activePlayer];
+    const PlayerState& opp = s.players[1 - s.activePlayer];
+    const Card& c = slotCard(s, m);
+    int score = greedyScore(s, m);
+    if (m.type == 1) {
+        if (c.chainCost != NONE_CHAIN && ((me.chainIcons >> c.chainCost) & 1)) score += 6;
+        // 新的连锁符号要到后面的时代才用得上
+        if (s.age < 3 && c.chainProvide != NONE_CHAIN && !((me.chainIcons >> c.chainProvide) & 1)) score += 3;
+    }
+    if (c.chainCost != NONE_CHAIN && ((opp.chainIcons >> c.chainCost) & 1)) score += 2;
+    return score;
+}
+
+MCTSMove Rollout::pickGreedy(const GameState& s, const MCTSMove moves[], int n, Rng& rng) {
+    return pickBest(s, moves, n, rng, greedyScore);
+}
+
+MCTSMove Rollout::pickEpsilonGreedy(const GameState& s, const MCTSMove moves[], int n, Rng& rng) {
+    if (rng.below(8) == 0) return moves[rng.below(n)];
+    return pickBest(s, moves, n, rng, valuePerCoinScore);
+}
+
+MCTSMove Rollout::pickMilitary(const GameState& s, const MCTSMove moves[], int n, Rng& rng) {
+    return pickBest(s, moves, n, rng, militaryScore);
+}
+
+MCTSMove Rollout::pickScience(const GameState& s, const MCTSMove moves[], int n, Rng& rng) {
+    return pickBest(s, moves, n, rng, scienceScore);
+}
+
+MCTSMove Rollout::pickChain(const GameState& s, const MCTSMove moves[], int n, Rng& rng) {
+    return pickBest(s, moves, n, rng, chainScore);
+}
+
+MCTSMove Rollout::pickMove(RolloutPolicy policy, const GameState& s, const MCTSMove moves[], int n, Rng& rng) {
+    switch (policy) {
+        case ROLLOUT_GREEDY: return pickGreedy(s, moves, n, rng);
+        case ROLLOUT_EPSILON: return pickEpsilonGreedy(s, moves, n, rng);
+        case ROLLOUT_MILITARY: return pickMilitary(s, moves, n, rng);
+        case ROLLOUT_SCIENCE: return pickScience(s, moves, n, rng);
+        case ROLLOUT_CHAIN: return pickChain(s, moves, n, rng);
+        default: return moves[rng.below(n)];
+    }
+}
+
+const char* Rollout::name(RolloutPolicy policy) {
+    return policy >= 0 && policy < ROLLOUT_POLICY_COUNT ? POLICY_NAMES[policy] : "?";
+}
+
+bool Rollout::parse(const string& name, RolloutPolicy& out) {
+    for (int i = 0; i < ROLLOUT_POLICY_COUNT; i++) {
+        if (name == POLICY_NAMES[i]) {
+            out = (RolloutPolicy)i;
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,41 @@
+/**
+ * @file Rollout.h
+ * @brief 模拟阶段 (rollout) 的走子策略库
+ * 作用：搜索把局面模拟到终局时，每一步都要从合法行动中挑一个。
+ *      这里的每种策略只读 GameState、只消耗调用方传入的随机源，不分配内存，
+ *      由 MCTSConfig::rollout / ParallelMCTSConfig::rollout 按搜索选择。
+ *      策略越聪明，单局模拟越慢；“每纳秒的模拟质量”用 bench --eval-rollouts 评估。
+ */
+
+#ifndef ROLLOUT_H
+#define ROLLOUT_H
+
+#include "MCTS.h"
+#include <string>
+
+class Rollout {
+public:
+    /**
+     * @brief 按 policy 从 moves 中挑一个行动
+     * @param moves generateMoves(s) 的结果，n > 0
+     */
+    static MCTSMove pickMove(RolloutPolicy policy, const GameState& s, const MCTSMove moves[], int n, Rng& rng);
+
+    // 奇迹优先，其次是分数、军事、科技、资源较多的卡，弃牌最低；同分随机
+    static MCTSMove pickGreedy(const GameState& s, const MCTSMove moves[], int n, Rng& rng);
+    // 以 1/8 的概率随机走，否则挑“每金币胜利分”最高的行动
+    static MCTSMove pickEpsilonGreedy(const GameState& s, const MCTSMove moves[], int n, Rng& rng);
+    // 贪心 + 按军事条形势给盾牌加权；能直接军事胜利时必走，对手下一步能军事胜利时抢走那张牌
+    static MCTSMove pickMilitary(const GameState& s, const MCTSMove moves[], int n, Rng& rng);
+    // 贪心 + 新科技符号 / 凑对拿科技币加分；科技胜利的处理同上
+    static MCTSMove pickScience(const GameState& s, const MCTSMove moves[], int n, Rng& rng);
+    // 贪心 + 免费连锁、提供新连锁符号的卡加分，抢走对手能免费连锁的卡
+    static MCTSMove pickChain(const GameState& s, const MCTSMove moves[], int n, Rng& rng);
+
+    // 策略名 (random / greedy / epsilon / military / science / chain)
+    static const char* name(RolloutPolicy policy);
+    // 按策略名查找，未知的名字返回 false
+    static bool parse(const std::string& name, RolloutPolicy& out);
+};
+
+#endif
@@ -1,14 +1,15 @@
 #include "Strategy.h"
-#include "Game.h"
+#include "GameView.h"
+#include "CardDatabase.h"
 #include <iostream>
 #include <limits>
-#include <random>
+#include <bit>
 
 using namespace std;
 
 // --- HumanStrategy ---
 
-Action HumanStrategy::makeDecision(Game& game, Player& me, Player& opp) {
+Action HumanStrategy::makeDecision(const GameView& view) {
     int choice;
     cout << "请选择操作 (1:建造, 2:弃牌, 3:建造奇迹): ";
     while(!(cin >> choice) || choice < 1 || choice > 3) {
@@ -21,17 +22,18 @@ Action HumanStrategy::makeDecision(Game& game, Player& me, Player& opp) {
 
     int wIdx = -1;
     if (choice == 3) {
-        cout << "输入要建造的奇迹序号 (0-" << me.wonders.size()-1 << "): ";
+        cout << "输入要建造的奇迹序号 (0-" << view.me().wonders.size()-1 << "): ";
         cin >> wIdx;
     }
 
     return {choice, cardId, wIdx};
 }
 
-int HumanStrategy::chooseWonder(const std::vector<Wonder>& options, Game& game, Player& me) {
-    cout << me.name << " 请选择奇迹 (0-" << options.size()-1 << "): \n";
+int HumanStrategy::chooseWonder(const std::vector<int>& options, const GameView& view) {
+    cout << view.me().name << " 请选择奇迹 (0-" << options.size()-1 << "): \n";
     for(int i=0; i<options.size(); i++) {
-        cout << i << ": " << options[i].name << " (" << options[i].desc << ")\n";
+        const Wonder& w = CardDatabase::getWonder(options[i]);
+        cout << i << ": " << w.name << " (" << w.desc << ")\n";
     }
     int idx;
     while(!(cin >> idx) || idx < 0 || idx >= options.size()) {
@@ -40,22 +42,23 @@ int HumanStrategy::chooseWonder(const std::vector<Wonder>& options, Game& game,
     return idx;
 }
 
-int HumanStrategy::chooseCardFromDiscard(const std::vector<Card>& pile, Game& game) {
+int HumanStrategy::chooseCardFromDiscard(const std::vector<int>& pile, const GameView& view) {
     if(pile.empty()) return -1;
     cout << "请选择要复活的卡牌 (弃牌堆): \n";
     for(int i=0; i<pile.size(); i++) {
-        cout << i << ": " << pile[i].name << " (" << pile[i].getTypeColor() << ")\n";
+        const Card& c = CardDatabase::getCard(pile[i]);
+        cout << i << ": " << c.name << " (" << c.getTypeColor() << ")\n";
     }
     int idx;
     cin >> idx;
     return idx;
 }
 
-int HumanStrategy::chooseCardToDestroy(const std::vector<Card>& targets, Game& game) {
+int HumanStrategy::chooseCardToDestroy(const std::vector<int>& targets, const GameView& view) {
     if(targets.empty()) return -1;
     cout << "请选择要摧毁的对手卡牌: \n";
     for(int i=0; i<targets.size(); i++) {
-        cout << i << ": " << targets[i].name << "\n";
+        cout << i << ": " << CardDatabase::getCard(targets[i]).name << "\n";
     }
     int idx;
     cin >> idx;
@@ -63,7 +66,7 @@ int HumanStrategy::chooseCardToDestroy(const std::vector<Card>& targets, Game& g
 }
 
 // [修复3] Human实现
-int HumanStrategy::chooseToken(const std::vector<ProgressToken>& options, Game& game) {
+int HumanStrategy::chooseToken(const std::vector<ProgressToken>& options, const GameView& view) {
     if(options.empty()) return -1;
     cout << "大图书馆生效！请从以下科技币中选择一个: \n";
     for(int i=0; i<options.size(); i++) {
@@ -79,51 +82,105 @@ int HumanStrategy::chooseToken(const std::vector<ProgressToken>& options, Game&
 
 // --- GreedyAIStrategy ---
 
-Action GreedyAIStrategy::makeDecision(Game& game, Player& me, Player& opp) {
+Action GreedyAIStrategy::makeDecision(const GameView& view) {
     // 简单贪婪：优先买能买得起的、分最高的卡
-    vector<int> avail = game.getAvailableCards();
-    for(int id : avail) {
-        Card& c = game.getCard(id);
-        int cost = game.calculateCardCost(me, opp, c);
-        if (me.coins >= cost) {
-            return {1, id, -1};
+    auto ids = view.availableSlots();
+    auto costs = view.availableCosts();
+    for(size_t i = 0; i < ids.size(); i++) {
+        if (view.me().coins >= costs[i]) {
+            return {1, ids[i], -1};
         }
     }
     // 买不起就弃掉第一张
-    if(!avail.empty()) return {2, avail[0], -1};
+    if(!ids.empty()) return {2, ids[0], -1};
     return {2, 0, -1}; // fallback
 }
 
-int GreedyAIStrategy::chooseWonder(const std::vector<Wonder>& options, Game& game, Player& me) {
+int GreedyAIStrategy::chooseWonder(const std::vector<int>& options, const GameView& view) {
     return 0; // 总是选第一个
 }
-int GreedyAIStrategy::chooseCardFromDiscard(const std::vector<Card>& pile, Game& game) {
+int GreedyAIStrategy::chooseCardFromDiscard(const std::vector<int>& pile, const GameView& view) {
     return pile.size() - 1; // 选刚弃的那张
 }
-int GreedyAIStrategy::chooseCardToDestroy(const std::vector<Card>& targets, Game& game) {
+int GreedyAIStrategy::chooseCardToDestroy(const std::vector<int>& targets, const GameView& view) {
     return 0;
 }
-int GreedyAIStrategy::chooseToken(const std::vector<ProgressToken>& options, Game& game) {
+int GreedyAIStrategy::chooseToken(const std::vector<ProgressToken>& options, const GameView& view) {
     return 0; // 总是选第一个
 }
 
 
 // --- RandomAIStrategy ---
-Action RandomAIStrategy::makeDecision(Game& game, Player& me, Player& opp) {
-    vector<int> avail = game.getAvailableCards();
-    if(avail.empty()) return {2, 0, -1};
-    int id = avail[rand() % avail.size()];
+Action RandomAIStrategy::makeDecision(const GameView& view) {
+    uint32_t avail = view.availableMask();
+    if(avail == 0) return {2, 0, -1};
+    // 在可拿牌位掩码中随机选第 k 个置位
+    for(int k = rng.below(popcount(avail)); k > 0; k--) avail &= avail - 1;
+    int id = countr_zero(avail);
     return {1, id, -1}; // 尝试购买，买不起逻辑在Game::executeAction里会转为弃牌
 }
-int RandomAIStrategy::chooseWonder(const std::vector<Wonder>& options, Game& game, Player& me) {
-    return rand() % options.size();
+int RandomAIStrategy::chooseWonder(const std::vector<int>& options, const GameView& view) {
+    return rng.below(options.size());
 }
-int RandomAIStrategy::chooseCardFromDiscard(const std::vector<Card>& pile, Game& game) {
-    return rand() % pile.size();
+int RandomAIStrategy::chooseCardFromDiscard(const std::vector<int>& pile, const GameView& view) {
+    return rng.below(pile.size());
 }
-int RandomAIStrategy::chooseCardToDestroy(const std::vector<Card>& targets, Game& game) {
-    return rand() % targets.size();
+int RandomAIStrategy::chooseCardToDestroy(const std::vector<int>& targets, const GameView& view) {
+    return rng.below(targets.size());
+}
+int RandomAIStrategy::chooseToken(const std::vector<ProgressToken>& options, const GameView& view) {
+    return rng.below(options.size());
+}
+
+
+// --- SearchStrategy ---
+
+/**
+ * @brief 奇迹轮抽：此时版图尚未发牌，按奇迹本身的收益估值
+ */
+int SearchStrategy::chooseWonder(const std::vector<int>& options, const GameView& view) {
+    int best = 0, bestScore = -1;
+    for (int i = 0; i < options.size(); i++) {
+        const Wonder& w = CardDatabase::getWonder(options[i]);
+        int score = w.points + 2 * w.shields + w.coins / 3 + (w.extraTurn ? 4 : 0);
+        if (score > bestScore) { bestScore = score; best = i; }
+    }
+    return best;
+}
+
+// 与 GameState 的默认选择一致，保证搜索中的模拟与实际对局相符：复活分数最高的卡 (同分取编号小的)
+int SearchStrategy::chooseCardFromDiscard(const std::vector<int>& pile, const GameView& view) {
+    int best = -1, bestPoints = -1;
+    for (int i = 0; i < pile.size(); i++) {
+        int points = CardDatabase::getCard(pile[i]).points;
+        if (points > bestPoints || (points == bestPoints && pile[i] < pile[best])) { bestPoints = points; best = i; }
+    }
+    return best;
+}
+
+// 同上：摧毁产量最高的卡 (同产量取编号小的)
+int SearchStrategy::chooseCardToDestroy(const std::vector<int>& targets, const GameView& view) {
+    int best = -1, bestProd = -1;
+    for (int i = 0; i < targets.size(); i++) {
+        const Card& c = CardDatabase::getCard(targets[i]);
+        int prod = c.production[0] + c.production[1] + c.production[2] + c.production[3] + c.production[4];
+        if (prod > bestProd || (prod == bestProd && targets[i] < targets[best])) { bestProd = prod; best = i; }
+    }
+    return best;
+}
+
+/**
+ * @brief 大图书馆：搜索中拿到哪个科技币是随机的，这里按固定的优先级挑选
+ */
+int SearchStrategy::chooseToken(const std::vector<ProgressToken>& options, const GameView& view) {
+    static const ProgressToken PRIORITY[] = {
+        P_PHILOSOPHY, P_LAW, P_THEOLOGY, P_AGRICULTURE, P_URBANISM,
+        P_STRATEGY, P_MATHEMATICS, P_ECONOMY, P_MASONRY, P_ARCHITECTURE,
+    };
+    for (ProgressToken t : PRIORITY) {
+        for (int i = 0; i < options.size(); i++) {
+            if (options[i] == t) return i;
+        }
+    }
+    return 0;
 }
-int RandomAIStrategy::chooseToken(const std::vector<ProgressToken>& options, Game& game) {
-    return rand() % options.size();
-}
\ No newline at end of file
@@ -7,11 +7,12 @@
 #define STRATEGY_H
 
 #include "Structs.h"
+#include "Random.h"
+#include <cstdint>
 #include <string>
 #include <vector>
 
-class Game;
-struct Player;
+class GameView;
 
 struct Action {
     int type; // 1:建造, 2:弃牌, 3:奇迹
@@ -19,44 +20,92 @@ struct Action {
     int wonderIdx = -1;
 };
 
+/**
+ * @brief 把行动压缩成 1 字节：版图位置 * 6 + 种类 (0 建造, 1 弃牌, 2~5 建造第 0~3 个奇迹)
+ * 合法行动的编码都小于 120，NO_ACTION_CODE 表示“没有行动”。
+ */
+constexpr uint8_t NO_ACTION_CODE = 0xFF;
+
+inline uint8_t encodeAction(const Action& a) {
+    int kind = a.type == 3 ? 2 + a.wonderIdx : a.type - 1;
+    return (uint8_t)(a.cardId * 6 + kind);
+}
+
+inline Action decodeAction(uint8_t code) {
+    int kind = code % 6;
+    if (kind >= 2) return {3, code / 6, kind - 2};
+    return {kind + 1, code / 6, -1};
+}
+
+// 一个局面合法行动数的上界：每个可拿位置至多 1 建造 + 1 弃牌 + 4 奇迹
+constexpr int MAX_ACTIONS = 20 * 6;
+
+/**
+ * @class PlayerStrategy
+ * @brief 策略接口
+ * 每次询问都附带一个只读的 GameView (视角为被询问的一方)，策略无法修改对局，
+ * 也看不到背面朝上的牌。
+ */
 class PlayerStrategy {
 public:
     virtual ~PlayerStrategy() = default;
 
-    virtual Action makeDecision(Game& game, Player& me, Player& opp) = 0;
-    virtual int chooseWonder(const std::vector<Wonder>& options, Game& game, Player& me) = 0;
-    virtual int chooseCardFromDiscard(const std::vector<Card>& pile, Game& game) = 0;
-    virtual int chooseCardToDestroy(const std::vector<Card>& targets, Game& game) = 0;
+    virtual Action makeDecision(const GameView& view) = 0;
+    // 以下选项列表中均为奇迹 / 卡牌编号，属性通过 CardDatabase 查询
+    virtual int chooseWonder(const std::vector<int>& options, const GameView& view) = 0;
+    virtual int chooseCardFromDiscard(const std::vector<int>& pile, const GameView& view) = 0;
+    virtual int chooseCardToDestroy(const std::vector<int>& targets, const GameView& view) = 0;
 
     // 新增接口：从给定的科技币列表中选择一个（用于大图书馆）
-    virtual int chooseToken(const std::vector<ProgressToken>& options, Game& game) = 0;
+    virtual int chooseToken(const std::vector<ProgressToken>& options, const GameView& view) = 0;
 };
 
 class HumanStrategy : public PlayerStrategy {
 public:
-    Action makeDecision(Game& game, Player& me, Player& opp) override;
-    int chooseWonder(const std::vector<Wonder>& options, Game& game, Player& me) override;
-    int chooseCardFromDiscard(const std::vector<Card>& pile, Game& game) override;
-    int chooseCardToDestroy(const std::vector<Card>& targets, Game& game) override;
-    int chooseToken(const std::vector<ProgressToken>& options, Game& game) override;
+    Action makeDecision(const GameView& view) override;
+    int chooseWonder(const std::vector<int>& options, const GameView& view) override;
+    int chooseCardFromDiscard(const std::vector<int>& pile, const GameView& view) override;
+    int chooseCardToDestroy(const std::vector<int>& targets, const GameView& view) override;
+    int chooseToken(const std::vector<ProgressToken>& options, const GameView& view) override;
 };
 
 class GreedyAIStrategy : public PlayerStrategy {
 public:
-    Action makeDecision(Game& game, Player& me, Player& opp) override;
-    int chooseWonder(const std::vector<Wonder>& options, Game& game, Player& me) override;
-    int chooseCardFromDiscard(const std::vector<Card>& pile, Game& game) override;
-    int chooseCardToDestroy(const std::vector<Card>& targets, Game& game) override;
-    int chooseToken(const std::vector<ProgressToken>& options, Game& game) override;
+    Action makeDecision(const GameView& view) override;
+    int chooseWonder(const std::vector<int>& options, const GameView& view) override;
+    int chooseCardFromDiscard(const std::vector<int>& pile, const GameView& view) override;
+    int chooseCardToDestroy(const std::vector<int>& targets, const GameView& view) override;
+    int chooseToken(const std::vector<ProgressToken>& options, const GameView& view) override;
 };
 
 class RandomAIStrategy : public PlayerStrategy {
 public:
-    Action makeDecision(Game& game, Player& me, Player& opp) override;
-    int chooseWonder(const std::vector<Wonder>& options, Game& game, Player& me) override;
-    int chooseCardFromDiscard(const std::vector<Card>& pile, Game& game) override;
-    int chooseCardToDestroy(const std::vector<Card>& targets, Game& game) override;
-    int chooseToken(const std::vector<ProgressToken>& options, Game& game) override;
+    // 只读视图拿不到对局的随机源，随机 AI 使用自己的
+    explicit RandomAIStrategy(uint64_t seed) : rng(seed) {}
+
+    Action makeDecision(const GameView& view) override;
+    int chooseWonder(const std::vector<int>& options, const GameView& view) override;
+    int chooseCardFromDiscard(const std::vector<int>& pile, const GameView& view) override;
+    int chooseCardToDestroy(const std::vector<int>& targets, const GameView& view) override;
+    int chooseToken(const std::vector<ProgressToken>& options, const GameView& view) override;
+
+private:
+    Rng rng;
+};
+
+/**
+ * @class SearchStrategy
+ * @brief 在 GameState 上搜索的策略的公共基类
+ * 搜索中陵墓 / 宙斯神像 / 竞技场的附带选择按 GameState 的默认规则模拟，
+ * 这里的钩子在实际对局中做出同样的选择，保证搜索的模拟与实际对局一致。
+ * 奇迹轮抽与大图书馆在搜索之外，按固定的估值 / 优先级选择。
+ */
+class SearchStrategy : public PlayerStrategy {
+public:
+    int chooseWonder(const std::vector<int>& options, const GameView& view) override;
+    int chooseCardFromDiscard(const std::vector<int>& pile, const GameView& view) override;
+    int chooseCardToDestroy(const std::vector<int>& targets, const GameView& view) override;
+    int chooseToken(const std::vector<ProgressToken>& options, const GameView& view) override;
 };
 
 #endif
\ No newline at end of file
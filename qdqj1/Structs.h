@@ -8,42 +8,41 @@
 #define STRUCTS_H
 
 #include "Enums.h"
-#include <map>
+#include <cstdint>
+#include <initializer_list>
 #include <string>
+#include <utility>
 #include <vector>
 
 /**
  * @struct Cost
  * @brief 费用结构体
  * 描述建造一个物品需要支付的代价。
+ * 资源按 Resource 下标存放在定长数组中，可在编译期构造。
  */
 struct Cost {
-    int coins = 0;                      // 需要支付的金币数量
-    std::map<Resource, int> resources;  // 需要支付的资源清单 (资源类型 -> 数量)
+    int coins = 0;                  // 需要支付的金币数量
+    uint8_t resources[5] = {};      // 需要支付的资源清单 (按 Resource 下标的数量)
 
     // --- 构造函数 ---
-    Cost() : coins(0) {}
-    Cost(int c, std::map<Resource, int> r = {}) : coins(c), resources(r) {}
+    constexpr Cost() {}
+    constexpr Cost(int c, std::initializer_list<std::pair<Resource, int>> r = {}) : coins(c) {
+        for (auto const& [res, count] : r) resources[res] = count;
+    }
 
     /**
      * @brief 将费用转换为字符串描述
      * 例如："2金 1木"
      */
     std::string toString() const {
-        if (coins == 0 && resources.empty()) return "免费";
         std::string s = "";
         if (coins > 0) s += std::to_string(coins) + "金 ";
-        for (auto const& [res, count] : resources) {
-            if (count > 0) {
-                std::string rName;
-                switch(res) {
-                    case WOOD: rName="木"; break; case CLAY: rName="土"; break;
-                    case STONE: rName="石"; break; case GLASS: rName="玻"; break;
-                    case PAPYRUS: rName="纸"; break; default: break;
-                }
-                s += std::to_string(count) + rName + " ";
+        for (int res = WOOD; res <= PAPYRUS; res++) {
+            if (resources[res] > 0) {
+                s += std::to_string(resources[res]) + getResourceName((Resource)res) + " ";
             }
         }
+        if (s.empty()) return "免费";
         return s;
     }
 };
@@ -52,15 +51,18 @@ struct Cost {
  * @struct Card
  * @brief 卡牌结构体
  * 描述一张卡牌的所有属性。
+ * 所有卡牌都在 CardDatabase 的编译期总表中定义，游戏中只传递卡牌编号。
  */
 struct Card {
-    std::string name;           // 卡牌名称
-    CardType type;              // 卡牌类型 (红/蓝/绿等)
+    int id = -1;                // 卡牌编号 (CardDatabase 总表中的下标)
+    int age = 0;                // 所属时代
+    const char* name = "";      // 卡牌名称
+    CardType type = RAW_MATERIAL; // 卡牌类型 (红/蓝/绿等)
     Cost cost;                  // 建造费用
     int points = 0;             // 提供的胜利点数 (VP)
     int shields = 0;            // 提供的军事盾牌数
     ScienceSymbol science = NO_SYMBOL; // 提供的科技符号
-    std::map<Resource, int> production; // 提供的资源产量
+    uint8_t production[5] = {}; // 提供的资源产量 (按 Resource 下标)
     int coinProduction = 0;     // 建造时一次性给予的金币
 
     // 连锁机制相关
@@ -71,25 +73,27 @@ struct Card {
     GuildType guildType = NO_GUILD;     // (仅紫色卡) 公会类型
 
     // 构造函数
-    Card() {}
-    Card(std::string n, CardType t, Cost c, int p=0, int s=0, ScienceSymbol sci=NO_SYMBOL)
+    constexpr Card() {}
+    constexpr Card(const char* n, CardType t, Cost c, int p=0, int s=0, ScienceSymbol sci=NO_SYMBOL)
          : name(n), type(t), cost(c), points(p), shields(s), science(sci) {}
 
     // --- 链式设置方法 (Builder Pattern) ---
-    Card& setProd(std::map<Resource, int> prod) { production = prod; return *this; }
-    Card& setChain(ChainSymbol provide, ChainSymbol costSym = NONE_CHAIN) { chainProvide = provide; chainCost = costSym; return *this; }
-    Card& setTrade(Resource res) { tradeDiscountRes = res; return *this; }
-    Card& setCoinProd(int c) { coinProduction = c; return *this; }
-    Card& setGuild(GuildType g) { guildType = g; return *this; }
+    constexpr Card& setProd(std::initializer_list<std::pair<Resource, int>> prod) {
+        for (auto const& [res, count] : prod) production[res] = count;
+        return *this;
+    }
+    constexpr Card& setChain(ChainSymbol provide, ChainSymbol costSym = NONE_CHAIN) { chainProvide = provide; chainCost = costSym; return *this; }
+    constexpr Card& setTrade(Resource res) { tradeDiscountRes = res; return *this; }
+    constexpr Card& setCoinProd(int c) { coinProduction = c; return *this; }
+    constexpr Card& setGuild(GuildType g) { guildType = g; return *this; }
 
     std::string getEffect() const {
         std::string s = "";
         if (points > 0) s += std::to_string(points) + "分 ";
         if (shields > 0) s += std::to_string(shields) + "盾 ";
         if (science != NO_SYMBOL) s += "科技 ";
-        for (auto const& [res, count] : production) {
-             std::string rName = (res==WOOD?"木":res==CLAY?"土":res==STONE?"石":res==GLASS?"玻":"纸");
-             s += "+" + std::to_string(count) + rName + " ";
+        for (int res = WOOD; res <= PAPYRUS; res++) {
+            if (production[res] > 0) s += "+" + std::to_string(production[res]) + getResourceName((Resource)res) + " ";
         }
         if (chainProvide != NONE_CHAIN) s += "[" + getChainName(chainProvide) + "] ";
         if (chainCost != NONE_CHAIN) s += "连锁:(" + getChainName(chainCost) + ") ";
@@ -115,20 +119,30 @@ struct Card {
 /**
  * @struct Wonder
  * @brief 奇迹结构体
+ * 只描述奇迹本身的属性；是否建成记录在玩家的 WonderSlot 中。
  */
 struct Wonder {
-    std::string name;   // 奇迹名称
-    Cost cost;          // 建造费用
-    int points = 0;     // 胜利点数
-    int shields = 0;    // 军事盾牌
-    int coins = 0;      // 获得的金币
-    bool built = false; // 状态：是否已建造
+    int id = -1;            // 奇迹编号 (即 WonderId)
+    const char* name = "";  // 奇迹名称
+    Cost cost;              // 建造费用
+    int points = 0;         // 胜利点数
+    int shields = 0;        // 军事盾牌
+    int coins = 0;          // 获得的金币
     bool extraTurn = false; // 是否提供额外回合
-    std::string desc;   // 效果描述文本
+    const char* desc = "";  // 效果描述文本
 
-    Wonder() {}
-    Wonder(std::string n, Cost c, int p, int s, int coin, bool b, bool extra, std::string d)
-        : name(n), cost(c), points(p), shields(s), coins(coin), built(b), extraTurn(extra), desc(d) {}
+    constexpr Wonder() {}
+    constexpr Wonder(const char* n, Cost c, int p, int s, int coin, bool extra, const char* d)
+        : name(n), cost(c), points(p), shields(s), coins(coin), extraTurn(extra), desc(d) {}
+};
+
+/**
+ * @struct WonderSlot
+ * @brief 玩家持有的一个奇迹
+ */
+struct WonderSlot {
+    int id;             // 奇迹编号
+    bool built = false; // 状态：是否已建造
 };
 
 /**
@@ -137,10 +151,9 @@ struct Wonder {
  */
 struct BoardSlot {
     int id;             // 唯一编号
-    Card card;          // 该位置存放的卡牌对象
+    int cardId;         // 该位置存放的卡牌编号
     bool faceUp;        // 是否正面朝上
-    bool taken = false; // 是否已被拿走
-    std::vector<int> coveredBy; // 覆盖列表
+    bool taken = false; // 是否已被拿走 (覆盖关系见 BoardLayout.h)
     int row;
     int col;
 };
@@ -151,4 +164,16 @@ struct CostBreakdown {
     int coinsToOpponent = 0; // 给对手的资源贸易费（受经济学标记影响）
 };
 
+/**
+ * @struct GameResult
+ * @brief 对局结果
+ * Game::simulate() 的返回值，供批量模拟统计胜率使用。
+ */
+struct GameResult {
+    int winner = -1;                // 胜者: 0 = 玩家1, 1 = 玩家2
+    VictoryType victory = V_NONE;   // 胜利方式
+    int scores[2] = {0, 0};         // 双方总分 (压制胜利时为当时的计分)
+    int moveCount = 0;              // 双方共执行的行动次数
+};
+
 #endif
\ No newline at end of file
@@ -0,0 +1,113 @@
+/**
+ * @file TranspositionTable.cpp
+ * @brief 无锁置换表的实现
+ */
+
+#include "TranspositionTable.h"
+#include "Strategy.h"
+#include <algorithm>
+#include <new>
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+using namespace std;
+
+static_assert(sizeof(atomic<uint64_t>) == 8 && atomic<uint64_t>::is_always_lock_free,
+              "置换表依赖无锁的 64 位原子读写");
+
+// data 字的布局：[0,16) 分值 | [16,24) 深度 | [24,26) 界 | [26,34) 行动 | [34,42) 代数
+static uint64_t pack(int score, int depth, BoundType bound, uint8_t move, uint8_t gen) {
+    return (uint64_t)(uint16_t)(int16_t)score
+         | (uint64_t)(uint8_t)depth << 16
+         | (uint64_t)bound << 24
+         | (uint64_t)move << 26
+         | (uint64_t)gen << 34;
+}
+static int unpackScore(uint64_t d) { return (int16_t)(uint16_t)d; }
+static int unpackDepth(uint64_t d) { return (uint8_t)(d >> 16); }
+static BoundType unpackBound(uint64_t d) { return (BoundType)((d >> 24) & 3); }
+static uint8_t unpackMove(uint64_t d) { return (uint8_t)(d >> 26); }
+static uint8_t unpackGen(uint64_t d) { return (uint8_t)(d >> 34); }
+
+TranspositionTable::TranspositionTable(size_t megabytes, bool hugePages) {
+    size_t bytes = max<size_t>(megabytes, 1) << 20;
+    bucketCount = 1;
+    while (bucketCount * 2 * sizeof(Bucket) <= bytes) bucketCount *= 2;
+    bytes = bucketCount * sizeof(Bucket);
+
+#ifdef __linux__
+    // 透明大页：按 2MB 对齐分配后提示内核使用大页，能减少随机访问时的 TLB 未命中
+    if (hugePages && bytes >= (2u << 20)) allocAlign = 2u << 20;
+#endif
+    void* mem = ::operator new(bytes, align_val_t(allocAlign));
+#ifdef __linux__
+    if (allocAlign > 64) madvise(mem, bytes, MADV_HUGEPAGE);
+#endif
+    buckets = new (mem) Bucket[bucketCount];
+    clear();
+}
+
+TranspositionTable::~TranspositionTable() {
+    for (size_t i = 0; i < bucketCount; i++) buckets[i].~Bucket();
+    ::operator delete(buckets, align_val_t(allocAlign));
+}
+
+void TranspositionTable::clear() {
+    for (size_t i = 0; i < bucketCount; i++) {
+        for (Slot& slot : buckets[i].slots) {
+            slot.keyXorData.store(0, memory_order_relaxed);
+            slot.data.store(0, memory_order_relaxed);
+        }
+    }
+    generation.store(0, memory_order_relaxed);
+}
+
+bool TranspositionTable::probe(uint64_t key, TTEntry& out) const {
+    const Bucket& bucket = buckets[key & (bucketCount - 1)];
+    for (const Slot& slot : bucket.slots) {
+        uint64_t data = slot.data.load(memory_order_relaxed);
+        uint64_t check = slot.keyXorData.load(memory_order_relaxed);
+        if ((check ^ data) != key || unpackBound(data) == BOUND_NONE) continue;
+        out = {unpackScore(data), unpackDepth(data), unpackBound(data), unpackMove(data)};
+        return true;
+    }
+    return false;
+}
+
+void TranspositionTable::store(uint64_t key, int score, int depth, BoundType bound, uint8_t move) {
+    Bucket& bucket = buckets[key & (bucketCount - 1)];
+    uint8_t gen = generation.load(memory_order_relaxed);
+    Slot* victim = nullptr;
+    int victimValue = 1 << 30;
+    for (Slot& slot : bucket.slots) {
+        uint64_t data = slot.data.load(memory_order_relaxed);
+        uint64_t check = slot.keyXorData.load(memory_order_relaxed);
+        if ((check ^ data) == key) {
+            // 同一局面：没有新的最佳行动时保留旧的
+            if (move == NO_ACTION_CODE) move = unpackMove(data);
+            victim = &slot;
+            break;
+        }
+        // 空条目价值最低；其余按深度减去“落后的代数”估值
+        int value = unpackBound(data) == BOUND_NONE ? -(1 << 20)
+                  : unpackDepth(data) - 8 * (uint8_t)(gen - unpackGen(data));
+        if (value < victimValue) { victimValue = value; victim = &slot; }
+    }
+    uint64_t data = pack(score, depth, bound, move, gen);
+    victim->data.store(data, memory_order_relaxed);
+    victim->keyXorData.store(key ^ data, memory_order_relaxed);
+}
+
+int TranspositionTable::hashfull() const {
+    size_t sample = min<size_t>(bucketCount, 1000);
+    uint8_t gen = generation.load(memory_order_relaxed);
+    int used = 0;
+    for (size_t i = 0; i < sample; i++) {
+        for (const Slot& slot : buckets[i].slots) {
+            uint64_t data = slot.data.load(memory_order_relaxed);
+            if (unpackBound(data) != BOUND_NONE && unpackGen(data) == gen) used++;
+        }
+    }
+    return used * 1000 / (int)(sample * ENTRIES_PER_BUCKET);
+}
@@ -0,0 +1,100 @@
+/**
+ * @file TranspositionTable.h
+ * @brief 多线程共享的无锁置换表
+ * 作用：不同的走子顺序常常到达同一个局面，搜索类策略把已搜过局面的结果
+ *      (深度、界类型、最佳行动、分值) 存在这里，按 GameState::hash 查询。
+ *      表大小在创建时固定，之后不再分配内存；多个搜索线程可直接共享同一张表，
+ *      读写都不加锁。
+ */
+
+#ifndef TRANSPOSITIONTABLE_H
+#define TRANSPOSITIONTABLE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @enum BoundType
+ * @brief 置换表中分值的含义 (alpha-beta 剪枝后分值可能只是一个界)
+ */
+enum BoundType {
+    BOUND_NONE,     // 空条目
+    BOUND_EXACT,    // 精确值
+    BOUND_LOWER,    // 下界 (发生了 beta 剪枝)
+    BOUND_UPPER     // 上界 (所有行动都没超过 alpha)
+};
+
+/**
+ * @struct TTEntry
+ * @brief 查询结果
+ */
+struct TTEntry {
+    int score;          // 分值 (从存入时行动方的视角)
+    int depth;          // 搜索深度，越大越可信
+    BoundType bound;
+    uint8_t move;       // 最佳行动 (encodeAction 编码)，NO_ACTION_CODE 表示无
+};
+
+/**
+ * @class TranspositionTable
+ * @brief 定长、按缓存行分桶、无锁的置换表
+ * 每个桶 64 字节，恰好一条缓存行，放 4 个条目；查询只访问一条缓存行。
+ * 每个条目是两个 64 位字：data 打包了分值 / 深度 / 界 / 行动 / 代数，
+ * 另一个字存 key ^ data。读到的两个字若来自两次不同的写入 (并发撕裂)，
+ * 异或校验不会通过，等同于未命中，因此不需要锁。
+ */
+class TranspositionTable {
+public:
+    /**
+     * @param megabytes 表的大小 (向下取到 2 的幂个桶)
+     * @param hugePages 是否尝试用大页承载 (仅 Linux，失败时退回普通内存)
+     */
+    explicit TranspositionTable(size_t megabytes, bool hugePages = false);
+    ~TranspositionTable();
+
+    TranspositionTable(const TranspositionTable&) = delete;
+    TranspositionTable& operator=(const TranspositionTable&) = delete;
+
+    /**
+     * @brief 查询局面
+     * @return 命中时返回 true 并填写 out
+     */
+    bool probe(uint64_t key, TTEntry& out) const;
+
+    /**
+     * @brief 写入局面
+     * 同一局面直接覆盖；否则替换桶中“最浅、最旧”的条目。
+     */
+    void store(uint64_t key, int score, int depth, BoundType bound, uint8_t move);
+
+    // 开始新的一次决策：旧条目保留可用，但替换时优先被淘汰
+    void newSearch() { generation.fetch_add(1, std::memory_order_relaxed); }
+
+    // 清空全部条目 (不可与搜索线程并发调用)
+    void clear();
+
+    size_t size() const { return bucketCount * ENTRIES_PER_BUCKET; }
+
+    // 抽样前 1000 个桶，估计本代条目的占用率 (千分比)
+    int hashfull() const;
+
+private:
+    static const int ENTRIES_PER_BUCKET = 4;
+
+    struct Slot {
+        std::atomic<uint64_t> keyXorData;
+        std::atomic<uint64_t> data;
+    };
+
+    struct alignas(64) Bucket {
+        Slot slots[ENTRIES_PER_BUCKET];
+    };
+
+    Bucket* buckets = nullptr;
+    size_t bucketCount = 0;
+    size_t allocAlign = 64;
+    std::atomic<uint8_t> generation{0};
+};
+
+#endif
@@ -0,0 +1,700 @@
+/**
+ * @file bench.cpp
+ * @brief 引擎热点函数的微基准与整局吞吐量的宏基准
+ * 用法：bench [--filter=<子串>] [--min-time=<秒>]
+ *      bench --verify-batch[=<局面数>]   对批量模拟后端做差分检查 (不运行基准)
+ *      bench --eval-rollouts[=<局面数>]  评估各模拟走子策略的速度与质量 (不运行基准)
+ *      bench --verify-replay[=<局数>]    检查对局记录的编码与重放 (不运行基准)
+ *      bench --verify-tt[=<线程数>]      多线程并发读写置换表，检查命中的条目没有撕裂 (不运行基准)
+ * 结果以与 Google Benchmark 相同的 JSON 格式输出到 stdout (可直接被其比较脚本读取)，
+ * 进度信息输出到 stderr。
+ * 每个基准先自动标定迭代次数，使总耗时不少于 min-time。
+ * BM_ParallelMCTS/<方式>/threads:<n> 是多线程 MCTS 的扩展性报告：
+ * 每次操作是一次固定迭代总数的决策，items_per_second 即每秒模拟局数。
+ * BM_ISMCTS/threads:<n> 同上，对象是信息集 MCTS。
+ * BM_Rollout/<...> 比较逐局模拟 (每种走子策略) 与 BatchRollout 的标量 / AVX2 实现，
+ * items_per_second 为每秒模拟局数。
+ */
+
+#include "Game.h"
+#include "GameView.h"
+#include "CardDatabase.h"
+#include "MCTS.h"
+#include "ParallelMCTS.h"
+#include "ISMCTS.h"
+#include "BatchRollout.h"
+#include "EndgameSolver.h"
+#include "TranspositionTable.h"
+#include "Rollout.h"
+#include "Replay.h"
+#include "ReplayCorpus.h"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+// 阻止编译器把被测结果当作无用代码删掉
+template <typename T>
+inline void doNotOptimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+/**
+ * @struct BenchResult
+ * @brief 单个基准的结果
+ */
+struct BenchResult {
+    string name;
+    long iterations;
+    double nsPerOp;         // 墙上时间
+    double cpuNsPerOp;      // 进程 CPU 时间 (所有线程之和)，多线程基准中大于墙上时间
+    double itemsPerSecond;  // 0 表示不输出 (宏基准中为每秒局数)
+};
+
+/**
+ * @brief 运行一个基准
+ * @param body 执行 n 次被测操作
+ * @param itemsPerOp 每次操作处理的条目数 (宏基准为 1 局)，0 表示不统计吞吐量
+ */
+static BenchResult runBenchmark(const string& name, double minTime, const function<void(long)>& body, int itemsPerOp = 0) {
+    using clock = chrono::steady_clock;
+    long n = 1;
+    double elapsed = 0, cpu = 0;
+    while (true) {
+        auto start = clock::now();
+        std::clock_t cpuStart = std::clock();
+        body(n);
+        cpu = (double)(std::clock() - cpuStart) / CLOCKS_PER_SEC;
+        elapsed = chrono::duration<double>(clock::now() - start).count();
+        if (elapsed >= minTime || n >= (1L << 40)) break;
+        // 按已测速度估算达到 minTime 所需的次数，每轮最多放大 10 倍
+        double scale = elapsed > 0 ? minTime * 1.4 / elapsed : 10;
+        n = (long)(n * min(10.0, max(2.0, scale)));
+    }
+    BenchResult r{name, n, elapsed * 1e9 / n, cpu * 1e9 / n, itemsPerOp ? itemsPerOp * n / elapsed : 0};
+    fprintf(stderr, "%-40s %12ld 次 %14.1f ns/次\n", name.c_str(), r.iterations, r.nsPerOp);
+    return r;
+}
+
+/**
+ * @class ReplayStrategy
+ * @brief 按给定的行动序列下棋 (双方共用一份序列)
+ * 附带选择与 GameState 的默认选择一致：陵墓 / 宙斯神像 / 竞技场沿用 SearchStrategy，
+ * 大图书馆拿洗牌后的第一个科技币。
+ * 每一步还核对 Game 列出的合法行动与 GameState 上 generateMoves 的结果逐项相同。
+ */
+class ReplayStrategy : public SearchStrategy {
+public:
+    struct Script {
+        vector<MCTSMove> moves;
+        size_t next = 0;
+        int moveListMismatches = 0;
+    };
+
+    explicit ReplayStrategy(shared_ptr<Script> script) : script(std::move(script)) {}
+
+    Action makeDecision(const GameView& view) override {
+        Action legal[MAX_ACTIONS];
+        MCTSMove expect[MAX_ACTIONS];
+        int n = view.legalActions(legal);
+        bool same = n == MCTSStrategy::generateMoves(view.publicSnapshot(), expect);
+        for (int i = 0; same && i < n; i++) {
+            same = legal[i].type == expect[i].type && legal[i].cardId == expect[i].cardId && legal[i].wonderIdx == expect[i].wonderIdx;
+        }
+        if (!same) script->moveListMismatches++;
+        if (script->next >= script->moves.size()) return {2, countr_zero(view.availableMask()), -1};
+        MCTSMove m = script->moves[script->next++];
+        return {m.type, m.cardId, m.wonderIdx};
+    }
+
+    int chooseToken(const vector<ProgressToken>& options, const GameView& view) override { return 0; }
+
+private:
+    shared_ptr<Script> script;
+};
+
+/**
+ * @class GameBenchmark
+ * @brief Game 的友元，用来直接调用私有的规则函数
+ */
+class GameBenchmark {
+public:
+    // 从开局随机走 moves 步得到一个中局局面 (走子在 GameState 上完成，再恢复到 Game)
+    static void playInto(Game& game, int moves, uint64_t seed) {
+        GameState s = game.snapshot();
+        Rng rng(seed);
+        MCTSMove buf[MAX_ACTIONS];
+        for (int i = 0; i < moves && !s.gameOver; i++) {
+            int n = MCTSStrategy::generateMoves(s, buf);
+            MCTSMove m = buf[rng.below(n)];
+            s.executeAction({m.type, m.cardId, m.wonderIdx});
+            s.advance();
+        }
+        game.restore(s);
+    }
+
+    static unique_ptr<Game> makeGame(uint64_t seed, int moves) {
+        auto game = make_unique<Game>("P1", make_unique<GreedyAIStrategy>(), "P2", make_unique<GreedyAIStrategy>(), seed, true);
+        playInto(*game, moves, seed);
+        return game;
+    }
+
+    static void registerAll(vector<pair<string, function<BenchResult(const string&, double)>>>& out) {
+        out.push_back({"BM_calculateResourceCost", [](const string& name, double t) {
+            auto game = makeGame(1, 25);
+            return runBenchmark(name, t, [&](long n) {
+                for (long i = 0; i < n; i++) {
+                    const Card& c = CardDatabase::getCard(i % CardDatabase::CARD_COUNT);
+                    doNotOptimize(Game::calculateResourceCost(game->p1, game->p2, c.cost, c.type, false));
+                }
+            });
+        }});
+        out.push_back({"BM_calculateCostDetails", [](const string& name, double t) {
+            auto game = makeGame(1, 25);
+            return runBenchmark(name, t, [&](long n) {
+                for (long i = 0; i < n; i++) {
+                    const Card& c = CardDatabase::getCard(i % CardDatabase::CARD_COUNT);
+                    doNotOptimize(game->calculateCostDetails(game->p1, game->p2, c.cost));
+                }
+            });
+        }});
+        out.push_back({"BM_getAvailableCards", [](const string& name, double t) {
+            auto game = makeGame(1, 25);
+            return runBenchmark(name, t, [&](long n) {
+                for (long i = 0; i < n; i++) doNotOptimize(game->getAvailableCards());
+            });
+        }});
+        out.push_back({"BM_generateLegalActions/Game", [](const string& name, double t) {
+            auto game = makeGame(1, 25);
+            Action actions[MAX_ACTIONS];
+            return runBenchmark(name, t, [&](long n) {
+                for (long i = 0; i < n; i++) doNotOptimize(game->generateLegalActions(game->p1, game->p2, actions));
+                doNotOptimize(actions);
+            });
+        }});
+        out.push_back({"BM_generateLegalActions/GameState", [](const string& name, double t) {
+            GameState s = makeGame(1, 25)->snapshot();
+            MCTSMove moves[MAX_ACTIONS];
+            return runBenchmark(name, t, [&](long n) {
+                for (long i = 0; i < n; i++) doNotOptimize(MCTSStrategy::generateMoves(s, moves));
+                doNotOptimize(moves);
+            });
+        }});
+        out.push_back({"BM_checkFaceUps", [](const string& name, double t) {
+            auto game = makeGame(1, 10);
+            // 只对已拿走的位置调用：重复调用结果不变，测的是纯粹的检查开销
+            vector<int> taken;
+            for (int id = 0; id < 20; id++) if ((game->takenMask >> id) & 1) taken.push_back(id);
+            return runBenchmark(name, t, [&](long n) {
+                for (long i = 0; i < n; i++) game->checkFaceUps(taken[i % taken.size()]);
+                doNotOptimize(game->availableMask);
+            });
+        }});
+        for (int age = 1; age <= 3; age++) {
+            out.push_back({"BM_setupAge/" + to_string(age), [age](const string& name, double t) {
+                auto game = makeGame(1, 0);
+                return runBenchmark(name, t, [&](long n) {
+                    for (long i = 0; i < n; i++) game->setupAge(age);
+                    doNotOptimize(game->board);
+                });
+            }});
+        }
+        for (int age = 1; age <= 3; age++) {
+            out.push_back({"BM_loadCardsForAge/" + to_string(age), [age](const string& name, double t) {
+                Rng rng(1);
+                return runBenchmark(name, t, [&](long n) {
+                    for (long i = 0; i < n; i++) doNotOptimize(CardDatabase::loadCardsForAge(age, rng));
+                });
+            }});
+        }
+        out.push_back({"BM_applyCardEffect", [](const string& name, double t) {
+            auto game = makeGame(1, 0);
+            Player base = game->p1;
+            return runBenchmark(name, t, [&](long n) {
+                for (long i = 0; i < n; i++) {
+                    // 每 64 张复位一次，避免已建造列表无限增长
+                    if ((i & 63) == 0) { game->p1 = base; game->militaryTrack = 0; }
+                    game->applyCardEffect(game->p1, CardDatabase::getCard(i % CardDatabase::CARD_COUNT));
+                }
+                doNotOptimize(game->p1.coins);
+            });
+        }});
+        out.push_back({"BM_applyUndoMove", [](const string& name, double t) {
+            auto game = makeGame(1, 25);
+            GameState s = game->snapshot();
+            MCTSMove moves[MAX_ACTIONS];
+            int n = MCTSStrategy::generateMoves(s, moves);
+            UndoStack undo;
+            return runBenchmark(name, t, [&](long iters) {
+                for (long i = 0; i < iters; i++) {
+                    MCTSMove m = moves[i % n];
+                    s.applyMove({m.type, m.cardId, m.wonderIdx}, -1, undo);
+                    s.undoMove(undo);
+                }
+                doNotOptimize(s);
+            });
+        }});
+        // 线程数 1, 2, 4, ... 直到硬件线程数
+        vector<int> threadCounts;
+        int hw = max(1u, thread::hardware_concurrency());
+        for (int n = 1; n < hw; n *= 2) threadCounts.push_back(n);
+        threadCounts.push_back(hw);
+        for (ParallelMode mode : {PARALLEL_ROOT, PARALLEL_TREE}) {
+            for (int threads : threadCounts) {
+                string label = string("BM_ParallelMCTS/") + (mode == PARALLEL_ROOT ? "root" : "tree") + "/threads:" + to_string(threads);
+                out.push_back({label, [mode, threads](const string& name, double t) {
+                    const int playouts = 4000;
+                    auto game = makeGame(1, 25);
+                    GameState s = game->snapshot();
+                    MCTSMove moves[MAX_ACTIONS];
+                    int n = MCTSStrategy::generateMoves(s, moves);
+                    ParallelMCTSConfig config;
+                    config.mode = mode;
+                    config.threads = threads;
+                    config.iterations = playouts;
+                    ParallelMCTSStrategy strategy(config);
+                    return runBenchmark(name, t, [&](long iters) {
+                        for (long i = 0; i < iters; i++) {
+                            vector<int> visits(n, 0);
+                            doNotOptimize(strategy.searchRoot(s, visits));
+                        }
+                    }, playouts);
+                }});
+            }
+        }
+        for (int threads : threadCounts) {
+            out.push_back({"BM_ISMCTS/threads:" + to_string(threads), [threads](const string& name, double t) {
+                const int playouts = 4000;
+                auto game = makeGame(1, 25);
+                GameState s = game->snapshot();
+                MCTSMove moves[MAX_ACTIONS];
+                int n = MCTSStrategy::generateMoves(s, moves);
+                ISMCTSConfig config;
+                config.threads = threads;
+                config.iterations = playouts;
+                ISMCTSStrategy strategy(config);
+                return runBenchmark(name, t, [&](long iters) {
+                    for (long i = 0; i < iters; i++) {
+                        vector<int> visits(n, 0);
+                        doNotOptimize(strategy.searchRoot(s, visits));
+                    }
+                }, playouts);
+            }});
+        }
+        for (int i = 0; i < ROLLOUT_POLICY_COUNT; i++) {
+            RolloutPolicy policy = (RolloutPolicy)i;
+            string suffix = string("/") + Rollout::name(policy);
+            out.push_back({"BM_Rollout/GameState" + suffix, [policy](const string& name, double t) {
+                GameState s = makeGame(1, 0)->snapshot();
+                Rng rng(1);
+                return runBenchmark(name, t, [&](long n) {
+                    for (long i = 0; i < n; i++) {
+                        GameState c = s;
+                        doNotOptimize(MCTSStrategy::rollout(c, policy, rng));
+                    }
+                }, 1);
+            }});
+            for (bool simd : {false, true}) {
+                if (policy != ROLLOUT_RANDOM && policy != ROLLOUT_GREEDY) break;
+                if (simd && !BatchRollout::simdSupported()) continue;
+                out.push_back({string("BM_Rollout/Batch") + (simd ? "AVX2" : "Scalar") + suffix, [policy, simd](const string& name, double t) {
+                    const int batch = 256;
+                    GameState s = makeGame(1, 0)->snapshot();
+                    BatchRollout rollouts(policy, simd);
+                    vector<RolloutOutcome> results(batch);
+                    return runBenchmark(name, t, [&](long n) {
+                        for (long i = 0; i < n; i++) rollouts.runFrom(s, batch, i + 1, results.data());
+                        doNotOptimize(results[0]);
+                    }, batch);
+                }});
+            }
+        }
+        out.push_back({"BM_Game/GreedyVsRandom", [](const string& name, double t) {
+            return runBenchmark(name, t, [](long n) {
+                for (long i = 0; i < n; i++) {
+                    Game game("P1", make_unique<GreedyAIStrategy>(), "P2", make_unique<RandomAIStrategy>((i + 1) ^ 2), i + 1, true);
+                    doNotOptimize(game.simulate());
+                }
+            }, 1);
+        }});
+        out.push_back({"BM_Game/RandomVsRandom", [](const string& name, double t) {
+            return runBenchmark(name, t, [](long n) {
+                for (long i = 0; i < n; i++) {
+                    Game game("P1", make_unique<RandomAIStrategy>((i + 1) ^ 1), "P2", make_unique<RandomAIStrategy>((i + 1) ^ 2), i + 1, true);
+                    doNotOptimize(game.simulate());
+                }
+            }, 1);
+        }});
+    }
+
+    /**
+     * @brief 批量模拟后端的差分检查
+     * 对每个中局局面：标量与 AVX2 实现的每局结果 (胜者、胜利方式、双方分数) 必须与
+     * MCTSStrategy::rollout 相同；再把批量模拟记录的行动序列交给 Game 本身重放，
+     * 结果也必须相同 (局面中的随机源沿用 Game 的，两边的后续发牌一致)，
+     * 重放的每一步 Game 列出的合法行动也必须与 GameState 的一致。
+     * @return 不一致的局数
+     */
+    static int verifyBatch(int positions) {
+        const int perPosition = 24;
+        int mismatches = 0, checked = 0;
+        for (int g = 1; g <= positions; g++) {
+            auto game = makeGame(g, (g * 7) % 45);
+            GameState root = game->snapshot();
+            for (int pi = 0; pi < ROLLOUT_POLICY_COUNT; pi++) {
+                RolloutPolicy policy = (RolloutPolicy)pi;
+                uint64_t seeds[perPosition];
+                for (int i = 0; i < perPosition; i++) seeds[i] = g * 1000003ull + i;
+                vector<RolloutOutcome> byBackend[2];
+                vector<MCTSMove> logs[perPosition];
+                for (int simd = 0; simd < 2; simd++) {
+                    BatchRollout rollouts(policy, simd);
+                    byBackend[simd].resize(perPosition);
+                    vector<GameState> roots(perPosition, root);
+                    rollouts.run(roots.data(), perPosition, seeds, byBackend[simd].data(), simd ? nullptr : logs);
+                }
+                for (int i = 0; i < perPosition; i++) {
+                    checked++;
+                    GameState c = root;
+                    Rng rng(seeds[i]);
+                    MCTSStrategy::rollout(c, policy, rng);
+                    RolloutOutcome expect = {c.winner, c.victory, (int16_t)c.calculateScore(0), (int16_t)c.calculateScore(1), 0};
+
+                    auto script = make_shared<ReplayStrategy::Script>();
+                    script->moves = logs[i];
+                    Game replay("P1", make_unique<ReplayStrategy>(script), "P2", make_unique<ReplayStrategy>(script), g, true);
+                    replay.restore(root);
+                    GameResult r = replay.simulate();
+
+                    bool ok = script->next == logs[i].size() && script->moveListMismatches == 0 && r.winner == expect.winner && r.victory == expect.victory
+                           && r.scores[0] == expect.scores[0] && r.scores[1] == expect.scores[1];
+                    for (const auto& results : byBackend) {
+                        const RolloutOutcome& o = results[i];
+                        ok = ok && o.winner == expect.winner && o.victory == expect.victory
+                                && o.scores[0] == expect.scores[0] && o.scores[1] == expect.scores[1];
+                    }
+                    if (!ok && ++mismatches <= 10) {
+                        fprintf(stderr, "不一致: 局面 %d, 策略 %d, 第 %d 局\n", g, policy, i);
+                    }
+                }
+            }
+        }
+        fprintf(stderr, "差分检查: %d 局, 不一致 %d 局 (AVX2 %s)\n", checked, mismatches,
+                BatchRollout::simdSupported() ? "已启用" : "不可用，仅检查标量实现");
+        return mismatches;
+    }
+
+    /**
+     * @brief 对局记录的往返检查
+     * 用几组策略 (含会触发陵墓 / 宙斯神像 / 竞技场 / 大图书馆选择的搜索类策略) 下完整局并记录，
+     * 编码成文件内容后再解析、重放，终局结果与终局快照的哈希必须与原对局相同；
+     * 再追加到临时的语料库里 mmap 读回，记录与摘要列也必须与原对局一致。
+     * @return 不一致的局数
+     */
+    static int verifyReplay(int games) {
+        auto makePair = [](int kind, uint64_t seed, unique_ptr<PlayerStrategy> out[2]) {
+            if (kind == 0) { out[0] = make_unique<GreedyAIStrategy>(); out[1] = make_unique<RandomAIStrategy>(seed); }
+            else if (kind == 1) { out[0] = make_unique<RandomAIStrategy>(seed); out[1] = make_unique<RandomAIStrategy>(seed ^ 1); }
+            else {
+                MCTSConfig config;
+                config.iterations = 100;
+                config.seed = seed;
+                out[0] = make_unique<MCTSStrategy>(config);
+                out[1] = make_unique<EndgameStrategy>(make_unique<GreedyAIStrategy>(), seed);
+            }
+        };
+        ReplayFile file;
+        file.strategies = {"greedy", "random", "mcts:100", "greedy+eg"};
+        const int kinds[3][2] = {{0, 1}, {1, 1}, {2, 3}};
+        vector<GameResult> expectResults;
+        vector<uint64_t> expectHashes;
+        for (int g = 0; g < games; g++) {
+            int kind = g % 3;
+            uint64_t seed = 1000 + g;
+            unique_ptr<PlayerStrategy> s[2];
+            makePair(kind, seed, s);
+            auto recorder = make_shared<ReplayRecorder>(seed, kinds[kind][0], kinds[kind][1]);
+            Game game("P1", ReplayRecorder::wrap(recorder, std::move(s[0])), "P2", ReplayRecorder::wrap(recorder, std::move(s[1])), seed, true);
+            expectResults.push_back(game.simulate());
+            expectHashes.push_back(game.snapshot().hash);
+            recorder->append(file.records);
+        }
+
+        // 经过完整的文件头编码 / 解析，与写入磁盘后读回的路径相同
+        vector<uint8_t> bytes;
+        ReplayFile::appendHeader(file.strategies, bytes);
+        size_t headerBytes = bytes.size();
+        bytes.insert(bytes.end(), file.records.begin(), file.records.end());
+        ReplayFile loaded;
+        bool headerOk = ReplayFile::parseHeader(bytes, loaded.strategies) == headerBytes && loaded.strategies == file.strategies;
+        loaded.records.assign(bytes.begin() + headerBytes, bytes.end());
+        vector<ReplayRecord> records = loaded.parseRecords();
+
+        int mismatches = headerOk && (int)records.size() == games ? 0 : 1;
+        for (int g = 0; g < (int)records.size() && g < games; g++) {
+            const ReplayRecord& rec = records[g];
+            GameState final;
+            GameResult r = rec.replay(&final);
+            const GameResult& e = expectResults[g];
+            bool ok = rec.seed == 1000u + g && rec.strategies[0] == kinds[g % 3][0] && rec.strategies[1] == kinds[g % 3][1]
+                   && rec.moveCount() == e.moveCount && r.winner == e.winner && r.victory == e.victory
+                   && r.scores[0] == e.scores[0] && r.scores[1] == e.scores[1] && r.moveCount == e.moveCount
+                   && final.hash == expectHashes[g];
+            if (!ok && ++mismatches <= 10) fprintf(stderr, "不一致: 第 %d 局\n", g);
+        }
+
+        string corpusPath = (filesystem::temp_directory_path() / "bench-verify-replay.7wdc").string();
+        filesystem::remove(corpusPath);
+        ReplayCorpus corpus;
+        if (!ReplayCorpus::append(corpusPath, loaded, 1) || !corpus.open(corpusPath) || corpus.gameCount() != (uint64_t)games) {
+            fprintf(stderr, "语料库写入 / 读取失败\n");
+            mismatches++;
+        } else {
+            for (int g = 0; g < games; g++) {
+                ReplayRecord rec;
+                ReplaySummary sum;
+                const GameResult& e = expectResults[g];
+                bool ok = corpus.record(g, rec) && corpus.summary(g, sum) && rec.seed == records[g].seed && rec.draft == records[g].draft
+                       && equal(rec.stream.begin(), rec.stream.end(), records[g].stream.begin(), records[g].stream.end())
+                       && sum.winner == e.winner && sum.victory == e.victory && sum.scores[0] == e.scores[0]
+                       && sum.scores[1] == e.scores[1] && sum.moves == e.moveCount
+                       && corpus.segmentOf(g)->strategies == file.strategies;
+                if (!ok && ++mismatches <= 10) fprintf(stderr, "语料库不一致: 第 %d 局\n", g);
+            }
+            ReplayRecord rec;
+            if (corpus.segmentOf(games) || corpus.record(games, rec)) {
+                fprintf(stderr, "语料库越界编号未被拒绝\n");
+                mismatches++;
+            }
+            // 再追加一段并截掉末尾 10 字节 (模拟中断的追加)，之后的追加应接在第一段之后
+            corpus.close();
+            bool ok = ReplayCorpus::append(corpusPath, loaded, 1);
+            filesystem::resize_file(corpusPath, filesystem::file_size(corpusPath) - 10);
+            ok = ok && ReplayCorpus::append(corpusPath, loaded, 1) && corpus.open(corpusPath)
+              && corpus.gameCount() == 2 * (uint64_t)games && corpus.validBytes() == corpus.mappedBytes();
+            if (!ok) {
+                fprintf(stderr, "截断末段后的追加失败\n");
+                mismatches++;
+            }
+        }
+        corpus.close();
+        filesystem::remove(corpusPath);
+        fprintf(stderr, "对局记录检查: %d 局, 不一致 %d 局, 平均 %.1f 字节/局 (文件头 %zu 字节)\n", games, mismatches,
+                (double)file.records.size() / max(1, games), headerBytes);
+        return mismatches;
+    }
+
+    /**
+     * @brief 置换表的并发检查
+     * 多个线程在一张小表上对同一组键随机交替写入 / 查询，每个键写入的内容都由键本身推出；
+     * 查询命中时内容必须与键对应，否则说明读到了两次写入拼成的撕裂条目。
+     * 键远多于表的容量，同一个桶不断被各线程替换，最大限度地制造并发冲突。
+     * @return 内容不符的命中次数
+     */
+    static int verifyTranspositionTable(int threads) {
+        const int KEY_COUNT = 1 << 18;
+        const long OPS_PER_THREAD = 2000000;
+        vector<uint64_t> keys(KEY_COUNT);
+        for (int k = 0; k < KEY_COUNT; k++) keys[k] = Rng(k + 1)();
+        auto expected = [](uint64_t key) {
+            return TTEntry{(int16_t)(key >> 48), (int)((key >> 8) & 63), (BoundType)(BOUND_EXACT + (key >> 16) % 3),
+                           (uint8_t)((key >> 24) % MAX_ACTIONS)};
+        };
+
+        TranspositionTable table(4, true);
+        atomic<long> hits{0}, corrupted{0};
+        vector<thread> pool;
+        for (int t = 0; t < threads; t++) {
+            pool.emplace_back([&, t] {
+                Rng rng(t + 1);
+                long localHits = 0, localCorrupted = 0;
+                for (long i = 0; i < OPS_PER_THREAD; i++) {
+                    uint64_t key = keys[rng.below(KEY_COUNT)];
+                    TTEntry want = expected(key);
+                    if (rng() & 1) {
+                        table.store(key, want.score, want.depth, want.bound, want.move);
+                        continue;
+                    }
+                    TTEntry e;
+                    if (!table.probe(key, e)) continue;
+                    localHits++;
+                    if (e.score != want.score || e.depth != want.depth || e.bound != want.bound || e.move != want.move) localCorrupted++;
+                }
+                hits += localHits;
+                corrupted += localCorrupted;
+            });
+        }
+        for (auto& th : pool) th.join();
+        fprintf(stderr, "置换表检查: %d 线程, %ld 次操作, 命中 %ld 次, 内容不符 %ld 次\n",
+                threads, threads * OPS_PER_THREAD, hits.load(), corrupted.load());
+        return (int)corrupted.load();
+    }
+
+    /**
+     * @brief 模拟走子策略的评估，每种策略报告四项：
+     * 速度：从开局模拟到终局的平均耗时；
+     * 对弈：与 greedy 各执一方 (交换座位) 走完整局的胜率，衡量策略本身的棋力；
+     * 估值：第三时代的牌全部翻开后，残局求解器给出行动方的真实胜负，
+     *      比较模拟胜率与真实结果的 Brier 分数 (越低越好)，
+     *      分别在每个局面固定模拟局数和固定时间预算 (即每纳秒的模拟质量) 下统计。
+     */
+    static void evalRollouts(int positions) {
+        using clock = chrono::steady_clock;
+        const int duelsPerPosition = 20;
+        const int perPosition = 16;
+        const auto budget = chrono::microseconds(200);
+        MCTSMove moves[MAX_ACTIONS];
+
+        vector<GameState> openings, endgames;
+        vector<int> truth;      // 残局中行动方是否必胜
+        EndgameSolver solver(nullptr, 64);
+        for (int g = 1; g <= positions; g++) {
+            GameState s = makeGame(g, 0)->snapshot();
+            openings.push_back(s);
+            Rng rng(g);
+            while (!s.gameOver && !EndgameSolver::solvable(s)) {
+                MCTSMove m = Rollout::pickEpsilonGreedy(s, moves, MCTSStrategy::generateMoves(s, moves), rng);
+                s.executeAction({m.type, m.cardId, m.wonderIdx});
+                s.advance();
+            }
+            if (s.gameOver) continue;
+            // 求解与模拟使用同一个随机源 (大图书馆)
+            s.rng.reseed(g);
+            MCTSMove best;
+            truth.push_back(solver.solve(s, best, g) > 0);
+            endgames.push_back(s);
+        }
+
+        printf("%d 个开局, %zu 个残局 (行动方必胜 %d 个)\n", positions, endgames.size(),
+               (int)count(truth.begin(), truth.end(), 1));
+        printf("%-10s %12s %12s %14s %14s %12s\n", "策略", "ns/局", "对greedy胜率", "Brier@16局", "Brier@200us", "200us局数");
+        for (int pi = 0; pi < ROLLOUT_POLICY_COUNT; pi++) {
+            RolloutPolicy policy = (RolloutPolicy)pi;
+            long games = (long)positions * duelsPerPosition;
+
+            auto start = clock::now();
+            for (long i = 0; i < games; i++) {
+                GameState s = openings[i % positions];
+                Rng rng(i + 1);
+                doNotOptimize(MCTSStrategy::rollout(s, policy, rng));
+            }
+            double ns = chrono::duration<double, nano>(clock::now() - start).count() / games;
+
+            long wins = 0;
+            for (long i = 0; i < games; i++) {
+                GameState s = openings[i / duelsPerPosition];
+                int seat = i & 1;
+                Rng rng(i + 1);
+                while (!s.gameOver) {
+                    int n = MCTSStrategy::generateMoves(s, moves);
+                    MCTSMove m = Rollout::pickMove(s.activePlayer == seat ? policy : ROLLOUT_GREEDY, s, moves, n, rng);
+                    s.executeAction({m.type, m.cardId, m.wonderIdx});
+                    s.advance();
+                }
+                wins += s.winner == seat;
+            }
+
+            double brierFixed = 0, brierTimed = 0;
+            long timedGames = 0;
+            for (size_t e = 0; e < endgames.size(); e++) {
+                int mover = endgames[e].activePlayer;
+                int won = 0;
+                for (int k = 0; k < perPosition; k++) {
+                    GameState s = endgames[e];
+                    Rng rng(e * 7919 + k + 1);
+                    won += MCTSStrategy::rollout(s, policy, rng) == mover;
+                }
+                double p = (double)won / perPosition;
+                brierFixed += (p - truth[e]) * (p - truth[e]);
+
+                won = 0;
+                int played = 0;
+                auto deadline = clock::now() + budget;
+                Rng rng(e + 1);
+                do {
+                    GameState s = endgames[e];
+                    won += MCTSStrategy::rollout(s, policy, rng) == mover;
+                    played++;
+                } while (clock::now() < deadline);
+                p = (double)won / played;
+                brierTimed += (p - truth[e]) * (p - truth[e]);
+                timedGames += played;
+            }
+            double solved = max<size_t>(1, endgames.size());
+            printf("%-10s %12.0f %11.1f%% %14.4f %14.4f %12.1f\n", Rollout::name(policy), ns, 100.0 * wins / games,
+                   brierFixed / solved, brierTimed / solved, timedGames / solved);
+        }
+    }
+};
+
+int main(int argc, char** argv) {
+    string filter;
+    double minTime = 0.5;
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], "--filter=", 9) == 0) filter = argv[i] + 9;
+        else if (strncmp(argv[i], "--min-time=", 11) == 0) minTime = atof(argv[i] + 11);
+        else if (strncmp(argv[i], "--verify-batch", 14) == 0) {
+            int positions = argv[i][14] == '=' ? atoi(argv[i] + 15) : 50;
+            return GameBenchmark::verifyBatch(positions) == 0 ? 0 : 1;
+        }
+        else if (strncmp(argv[i], "--verify-replay", 15) == 0) {
+            return GameBenchmark::verifyReplay(argv[i][15] == '=' ? atoi(argv[i] + 16) : 300) == 0 ? 0 : 1;
+        }
+        else if (strncmp(argv[i], "--verify-tt", 11) == 0) {
+            return GameBenchmark::verifyTranspositionTable(argv[i][11] == '=' ? atoi(argv[i] + 12) : 4) == 0 ? 0 : 1;
+        }
+        else if (strncmp(argv[i], "--eval-rollouts", 15) == 0) {
+            GameBenchmark::evalRollouts(argv[i][15] == '=' ? atoi(argv[i] + 16) : 50);
+            return 0;
+        }
+        else {
+            fprintf(stderr, "用法: %s [--filter=<子串>] [--min-time=<秒>] | --verify-batch[=<局面数>] | --verify-replay[=<局数>] | --verify-tt[=<线程数>] | --eval-rollouts[=<局面数>]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    vector<pair<string, function<BenchResult(const string&, double)>>> all;
+    GameBenchmark::registerAll(all);
+    vector<BenchResult> results;
+    for (auto& [name, fn] : all) {
+        if (filter.empty() || name.find(filter) != string::npos) results.push_back(fn(name, minTime));
+    }
+
+    char date[32];
+    time_t now = time(nullptr);
+    strftime(date, sizeof date, "%Y-%m-%dT%H:%M:%S", localtime(&now));
+    printf("{\n  \"context\": {\n");
+    printf("    \"date\": \"%s\",\n", date);
+    printf("    \"executable\": \"%s\",\n", argv[0]);
+    printf("    \"num_cpus\": %u,\n", thread::hardware_concurrency());
+#ifdef NDEBUG
+    printf("    \"library_build_type\": \"release\"\n");
+#else
+    printf("    \"library_build_type\": \"debug\"\n");
+#endif
+    printf("  },\n  \"benchmarks\": [\n");
+    for (size_t i = 0; i < results.size(); i++) {
+        const BenchResult& r = results[i];
+        printf("    {\n");
+        printf("      \"name\": \"%s\",\n", r.name.c_str());
+        printf("      \"run_type\": \"iteration\",\n");
+        printf("      \"iterations\": %ld,\n", r.iterations);
+        printf("      \"real_time\": %.4f,\n", r.nsPerOp);
+        printf("      \"cpu_time\": %.4f,\n", r.cpuNsPerOp);
+        printf("      \"time_unit\": \"ns\"");
+        if (r.itemsPerSecond > 0) printf(",\n      \"items_per_second\": %.4f", r.itemsPerSecond);
+        printf("\n    }%s\n", i + 1 < results.size() ? "," : "");
+    }
+    printf("  ]\n}\n");
+    return 0;
+}
@@ -1,19 +1,29 @@
 #include <iostream>
 #include <memory>
+#include <random>
 #include "Game.h"
 #include "Strategy.h"
 #include "Extension.h"
+#include "MCTS.h"
+#include "Expectiminimax.h"
+#include "ParallelMCTS.h"
+#include "ISMCTS.h"
 
 using namespace std;
 
 // 辅助函数：选择策略类型
-std::unique_ptr<PlayerStrategy> chooseStrategy(string playerName) {
+// seed 是该座位 AI 自己的随机种子 (由本局种子推出，保证整局可复现)
+std::unique_ptr<PlayerStrategy> chooseStrategy(string playerName, uint64_t seed) {
     int choice;
     cout << "为 " << playerName << " 选择控制者类型:" << endl;
     cout << "1. 人类玩家" << endl;
     cout << "2. 智能 AI (贪婪策略)" << endl;
     cout << "3. 随机 AI (简单测试)" << endl;
-    cout << "请输入选项 (1-3): ";
+    cout << "4. 搜索 AI (蒙特卡洛树搜索)" << endl;
+    cout << "5. 搜索 AI (期望极小化极大)" << endl;
+    cout << "6. 搜索 AI (多线程蒙特卡洛树搜索，每步 1 秒)" << endl;
+    cout << "7. 搜索 AI (多线程信息集蒙特卡洛树搜索，每步 1 秒)" << endl;
+    cout << "请输入选项 (1-7): ";
     cin >> choice;
 
     // 清除输入缓冲，防止后续读取名字出错
@@ -23,8 +33,31 @@ std::unique_ptr<PlayerStrategy> chooseStrategy(string playerName) {
     switch(choice) {
     case 1: return std::make_unique<HumanStrategy>();
     case 2: return std::make_unique<GreedyAIStrategy>();
-    case 3: return std::make_unique<RandomAIStrategy>(); // 至少一种简单AI
-    default: return std::make_unique<RandomAIStrategy>();
+    case 3: return std::make_unique<RandomAIStrategy>(seed); // 至少一种简单AI
+    case 4: {
+        MCTSConfig config;
+        config.seed = seed;
+        return std::make_unique<MCTSStrategy>(config);
+    }
+    case 5: {
+        ExpectiminimaxConfig config;
+        config.seed = seed;
+        return std::make_unique<ExpectiminimaxStrategy>(config);
+    }
+    case 6: {
+        ParallelMCTSConfig config;
+        config.timeBudgetMs = 1000;
+        config.seed = seed;
+        return std::make_unique<ParallelMCTSStrategy>(config);
+    }
+    case 7: {
+        ISMCTSConfig config;
+        config.threads = 0;
+        config.timeBudgetMs = 1000;
+        config.seed = seed;
+        return std::make_unique<ISMCTSStrategy>(config);
+    }
+    default: return std::make_unique<RandomAIStrategy>(seed);
     }
 }
 
@@ -34,15 +67,19 @@ int main() {
     cout << "       LO02 项目 - 秋季 2025           " << endl;
     cout << "========================================" << endl;
 
+    // 本局的全部随机性都由这一个种子推出：发牌用它本身，双方 AI 各用它与座位号的异或
+    // 随机种子会打印出来，记下它即可复现同一局
+    uint64_t seed = ((uint64_t)random_device{}() << 32) | random_device{}();
+
     // 1. 配置玩家
     string p1Name, p2Name;
     cout << "请输入玩家 1 名字: ";
     getline(cin, p1Name);
-    auto s1 = chooseStrategy(p1Name);
+    auto s1 = chooseStrategy(p1Name, seed ^ 1);
 
     cout << "请输入玩家 2 名字: ";
     getline(cin, p2Name);
-    auto s2 = chooseStrategy(p2Name);
+    auto s2 = chooseStrategy(p2Name, seed ^ 2);
 
     // 2. 配置扩展 (展示架构对扩展的支持)
     bool enableExpansion = false;
@@ -51,7 +88,8 @@ int main() {
 
     // 3. 初始化并运行游戏
     // 使用 std::move 将策略的所有权转移给 Game 对象
-    Game game(p1Name, std::move(s1), p2Name, std::move(s2));
+    cout << "本局随机种子: " << seed << endl;
+    Game game(p1Name, std::move(s1), p2Name, std::move(s2), seed);
 
     // 动态添加扩展
     if (enableExpansion) {
@@ -0,0 +1,245 @@
+/**
+ * @file replay_scan.cpp
+ * @brief 对局语料库的建立与多线程筛选
+ * 用法：replay-scan <语料文件> --append=<记录文件> [--threads=<n>]
+ *          把 tournament --record 写出的记录文件追加为新的段 (摘要由重放得到)
+ *      replay-scan <语料文件> [条件...] [--threads=<n>] [--list=<条数>]
+ *          按摘要列筛选，条件之间为“且” (同一条件给出多次时每一次都要满足)：
+ *          --victory=military|science|civilian   胜利方式
+ *          --winner=1|2                          胜者座位
+ *          --winner-built=<奇迹>                 胜者建成了该奇迹
+ *          --picked=<奇迹>                       任意一方轮抽到该奇迹
+ *          --guild=<公会>                        第三时代版图上发到了该公会卡
+ *          --min-margin=<分差>                   胜者领先的分数不少于该值
+ *          奇迹 / 公会可以写名称 (如 大图书馆、科学家公会) 或编号。
+ * 例：科技压制且胜者建成了大图书馆的对局
+ *      replay-scan games.7wdc --victory=science --winner-built=大图书馆
+ * 筛选只读取用到的摘要列；语料库被切成固定大小的块，工作线程循环领取下一块，
+ * 线程之间除了领取块号的原子计数器外不共享任何状态。
+ */
+
+#include "ReplayCorpus.h"
+#include "CardDatabase.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+/**
+ * @struct ScanFilter
+ * @brief 筛选条件，未给出的条件不检查
+ * 奇迹 / 公会条件每给出一次记一个单独的位 (不合并成一个掩码)，逐个检查后相与。
+ */
+struct ScanFilter {
+    int victory = -1;
+    int winner = -1;
+    vector<uint16_t> winnerBuilt;
+    vector<uint16_t> picked;
+    vector<uint8_t> guilds;
+    int minMargin = INT_MIN;
+
+    /**
+     * @brief 统计 [begin, end) 中符合条件的局；matches 不为空时记下它们在段内的编号
+     * 按列逐块筛选：每个给出的条件对一块数据单独走一遍，把结果与进字节掩码。
+     * 每一遍只读一两列、循环体没有分支，编译器可以直接向量化。
+     */
+    long scan(const ReplayCorpus::Segment& s, uint32_t begin, uint32_t end, vector<uint32_t>* matches) const {
+        const uint32_t BLOCK = 4096;
+        uint8_t keep[BLOCK];
+        long count = 0;
+        for (uint32_t b = begin; b < end; b += BLOCK) {
+            uint32_t n = min(BLOCK, end - b);
+            memset(keep, 1, n);
+            const int8_t* win = s.winner + b;
+            if (victory >= 0) {
+                const uint8_t* v = s.victory + b;
+                for (uint32_t j = 0; j < n; j++) keep[j] &= v[j] == victory;
+            }
+            if (winner >= 0) {
+                for (uint32_t j = 0; j < n; j++) keep[j] &= win[j] == winner;
+            }
+            for (uint16_t w : winnerBuilt) {
+                const uint16_t* b0 = s.wondersBuilt[0] + b;
+                const uint16_t* b1 = s.wondersBuilt[1] + b;
+                for (uint32_t j = 0; j < n; j++) {
+                    // 按胜者选列 (未分胜负时两列都不选)，用掩码代替分支
+                    uint16_t built = (b0[j] & -(uint16_t)(win[j] == 0)) | (b1[j] & -(uint16_t)(win[j] == 1));
+                    keep[j] &= (built & w) != 0;
+                }
+            }
+            for (uint16_t w : picked) {
+                const uint16_t* p0 = s.wondersPicked[0] + b;
+                const uint16_t* p1 = s.wondersPicked[1] + b;
+                for (uint32_t j = 0; j < n; j++) keep[j] &= ((p0[j] | p1[j]) & w) != 0;
+            }
+            for (uint8_t guild : guilds) {
+                const uint8_t* g = s.guilds + b;
+                for (uint32_t j = 0; j < n; j++) keep[j] &= (g[j] & guild) != 0;
+            }
+            if (minMargin != INT_MIN) {
+                const int16_t* s0 = s.scores[0] + b;
+                const int16_t* s1 = s.scores[1] + b;
+                for (uint32_t j = 0; j < n; j++) {
+                    int sign = (win[j] == 0) - (win[j] == 1);
+                    keep[j] &= (win[j] >= 0) & ((s0[j] - s1[j]) * sign >= minMargin);
+                }
+            }
+            for (uint32_t j = 0; j < n; j++) count += keep[j];
+            if (matches) {
+                for (uint32_t j = 0; j < n; j++) if (keep[j]) matches->push_back(b + j);
+            }
+        }
+        return count;
+    }
+
+    // 每局读取的摘要列字节数，用于换算扫描带宽
+    int bytesPerGame() const {
+        int bytes = 0;
+        if (victory >= 0) bytes += 1;
+        if (winner >= 0 || !winnerBuilt.empty() || minMargin != INT_MIN) bytes += 1;
+        if (!winnerBuilt.empty()) bytes += 4;
+        if (!picked.empty()) bytes += 4;
+        if (!guilds.empty()) bytes += 1;
+        if (minMargin != INT_MIN) bytes += 4;
+        return max(bytes, 1);
+    }
+};
+
+// 名称或编号 -> 奇迹编号，找不到返回 -1
+static int parseWonder(const char* arg) {
+    char* end;
+    long id = strtol(arg, &end, 10);
+    if (*end == '\0') return id >= 0 && id < CardDatabase::WONDER_COUNT ? (int)id : -1;
+    for (int w = 0; w < CardDatabase::WONDER_COUNT; w++) {
+        if (strcmp(CardDatabase::getWonder(w).name, arg) == 0) return w;
+    }
+    return -1;
+}
+
+// 名称或 GuildType 编号 -> 公会位，找不到返回 0
+static uint8_t parseGuild(const char* arg) {
+    char* end;
+    long g = strtol(arg, &end, 10);
+    for (int id = 0; id < CardDatabase::CARD_COUNT; id++) {
+        const Card& c = CardDatabase::getCard(id);
+        if (c.type != GUILD) continue;
+        if (*end == '\0' ? c.guildType == g : strcmp(c.name, arg) == 0) return (uint8_t)(1u << (c.guildType - 1));
+    }
+    return 0;
+}
+
+static int usage(const char* prog) {
+    fprintf(stderr, "用法: %s <语料文件> --append=<记录文件> [--threads=<n>]\n", prog);
+    fprintf(stderr, "      %s <语料文件> [--victory=military|science|civilian] [--winner=1|2] [--winner-built=<奇迹>]\n", prog);
+    fprintf(stderr, "          [--picked=<奇迹>] [--guild=<公会>] [--min-margin=<分差>] [--threads=<n>] [--list=<条数>]\n");
+    return 1;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) return usage(argv[0]);
+    string corpusPath = argv[1];
+    string appendPath;
+    int threads = (int)thread::hardware_concurrency();
+    long listLimit = 0;
+    ScanFilter filter;
+    for (int i = 2; i < argc; i++) {
+        const char* a = argv[i];
+        if (strncmp(a, "--append=", 9) == 0) appendPath = a + 9;
+        else if (strncmp(a, "--threads=", 10) == 0) threads = atoi(a + 10);
+        else if (strncmp(a, "--list=", 7) == 0) listLimit = atol(a + 7);
+        else if (strncmp(a, "--victory=", 10) == 0) {
+            const char* v = a + 10;
+            filter.victory = strcmp(v, "military") == 0 ? V_MILITARY : strcmp(v, "science") == 0 ? V_SCIENCE
+                           : strcmp(v, "civilian") == 0 ? V_CIVILIAN : -2;
+            if (filter.victory < 0) return usage(argv[0]);
+        }
+        else if (strncmp(a, "--winner=", 9) == 0) {
+            filter.winner = atoi(a + 9) - 1;
+            if (filter.winner != 0 && filter.winner != 1) return usage(argv[0]);
+        }
+        else if (strncmp(a, "--winner-built=", 15) == 0 || strncmp(a, "--picked=", 9) == 0) {
+            bool built = a[2] == 'w';
+            int w = parseWonder(strchr(a, '=') + 1);
+            if (w < 0) { fprintf(stderr, "未知奇迹: %s\n", strchr(a, '=') + 1); return 1; }
+            (built ? filter.winnerBuilt : filter.picked).push_back((uint16_t)(1u << w));
+        }
+        else if (strncmp(a, "--guild=", 8) == 0) {
+            uint8_t g = parseGuild(a + 8);
+            if (!g) { fprintf(stderr, "未知公会: %s\n", a + 8); return 1; }
+            filter.guilds.push_back(g);
+        }
+        else if (strncmp(a, "--min-margin=", 13) == 0) filter.minMargin = atoi(a + 13);
+        else return usage(argv[0]);
+    }
+    if (threads <= 0) threads = 1;
+
+    if (!appendPath.empty()) {
+        ReplayFile file;
+        if (!file.load(appendPath)) { fprintf(stderr, "无法读取记录文件: %s\n", appendPath.c_str()); return 1; }
+        auto start = chrono::steady_clock::now();
+        if (!ReplayCorpus::append(corpusPath, file, threads)) { fprintf(stderr, "无法写入语料库: %s\n", corpusPath.c_str()); return 1; }
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        printf("追加 %zu 局 (记录 %zu 字节), 用时 %.2f 秒\n", file.parseRecords().size(), file.records.size(), seconds);
+        return 0;
+    }
+
+    ReplayCorpus corpus;
+    if (!corpus.open(corpusPath)) { fprintf(stderr, "无法打开语料库: %s\n", corpusPath.c_str()); return 1; }
+
+    // 切块：每块不跨段，块号即结果的顺序
+    struct Chunk { const ReplayCorpus::Segment* seg; uint32_t begin, end; };
+    const uint32_t chunkGames = 1 << 16;
+    vector<Chunk> chunks;
+    for (const auto& s : corpus.segments()) {
+        for (uint32_t b = 0; b < s.gameCount; b += chunkGames) chunks.push_back({&s, b, min(s.gameCount, b + chunkGames)});
+    }
+    vector<long> counts(chunks.size(), 0);
+    vector<vector<uint32_t>> matches(listLimit > 0 ? chunks.size() : 0);
+
+    atomic<size_t> next{0};
+    auto worker = [&] {
+        for (size_t c; (c = next.fetch_add(1, memory_order_relaxed)) < chunks.size(); ) {
+            const Chunk& ch = chunks[c];
+            counts[c] = filter.scan(*ch.seg, ch.begin, ch.end, matches.empty() ? nullptr : &matches[c]);
+        }
+    };
+    auto start = chrono::steady_clock::now();
+    vector<thread> pool;
+    for (int t = 0; t < threads; t++) pool.emplace_back(worker);
+    for (auto& th : pool) th.join();
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    long total = 0;
+    for (long c : counts) total += c;
+    const char* victoryNames[4] = {"未结束", "军事压制", "科技压制", "终局计分"};
+    long listed = 0;
+    for (size_t c = 0; c < matches.size() && listed < listLimit; c++) {
+        const ReplayCorpus::Segment& s = *chunks[c].seg;
+        for (uint32_t i : matches[c]) {
+            if (listed++ >= listLimit) break;
+            ReplayRecord r = s.record(i);
+            ReplaySummary sum = s.summary(i);
+            auto name = [&](int p) { return r.strategies[p] < s.strategies.size() ? s.strategies[r.strategies[p]].c_str() : "?"; };
+            printf("#%llu 种子 %llu  %s vs %s  胜者 P%d (%s)  %d : %d  %d 步\n",
+                   (unsigned long long)(s.firstGame + i), (unsigned long long)r.seed, name(0), name(1),
+                   sum.winner + 1, victoryNames[sum.victory & 3], sum.scores[0], sum.scores[1], sum.moves);
+        }
+    }
+
+    uint64_t games = corpus.gameCount();
+    double scannedBytes = (double)games * filter.bytesPerGame();
+    printf("语料库 %llu 局 / %zu 段 (%.1f MB), 符合条件 %ld 局 (%.2f%%)\n",
+           (unsigned long long)games, corpus.segments().size(), corpus.mappedBytes() / 1e6, total,
+           games ? 100.0 * total / games : 0.0);
+    printf("扫描用时 %.3f 毫秒, %d 线程, %.1f 百万局/秒, 摘要列 %.2f GB/s\n",
+           seconds * 1e3, threads, games / seconds / 1e6, scannedBytes / seconds / 1e9);
+    return 0;
+}
@@ -0,0 +1,232 @@
+/**
+ * @file tournament.cpp
+ * @brief 多线程批量对战
+ * 用法：tournament <策略A> <策略B> [局数] [线程数] [种子] [--record=<文件>]
+ *      策略名：greedy / random / mcts / mcts:<迭代次数> / emm / emm:<毫秒> /
+ *              root:<线程数> / tree:<线程数> (多线程 MCTS，迭代总数同 mcts 默认值) /
+ *              ismcts / ismcts:<迭代次数> (信息集 MCTS)，
+ *      MCTS 类策略可再加 "/<模拟策略>" 选择 rollout 走子方式 (如 mcts:4000/science，见 Rollout.h)，
+ *      后面加 "+eg" 表示第三时代的牌全部翻开后改用残局求解器 (如 greedy+eg)
+ * 每个工作线程循环领取下一局的编号，为这一局创建自己的 Game 和策略对象，
+ * 线程之间除了领取编号的原子计数器外不共享任何状态。
+ * 第 2k 局与第 2k+1 局使用同一个种子并交换座位，抵消先手与发牌的影响。
+ * --record 把每一局按局号顺序写成对局记录 (格式见 Replay.h)，策略表为 {A, B}。
+ */
+
+#include "Game.h"
+#include "Strategy.h"
+#include "MCTS.h"
+#include "Expectiminimax.h"
+#include "EndgameSolver.h"
+#include "ParallelMCTS.h"
+#include "ISMCTS.h"
+#include "Rollout.h"
+#include "Replay.h"
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+/**
+ * @brief 按名字创建策略
+ * @param seed 搜索类策略自身使用的种子 (随对局变化，保证整场比赛可复现)
+ * @param rollout MCTS 类策略的模拟走子方式 (由 "/<模拟策略>" 后缀给出)
+ */
+static unique_ptr<PlayerStrategy> makeStrategy(const string& spec, uint64_t seed, RolloutPolicy rollout = ROLLOUT_GREEDY) {
+    if (spec.size() > 3 && spec.compare(spec.size() - 3, 3, "+eg") == 0) {
+        auto inner = makeStrategy(spec.substr(0, spec.size() - 3), seed, rollout);
+        if (!inner) return nullptr;
+        return make_unique<EndgameStrategy>(std::move(inner), seed);
+    }
+    size_t slash = spec.find('/');
+    if (slash != string::npos) {
+        RolloutPolicy policy;
+        if (!Rollout::parse(spec.substr(slash + 1), policy)) return nullptr;
+        if (spec.rfind("mcts", 0) != 0 && spec.rfind("root", 0) != 0 && spec.rfind("tree", 0) != 0
+            && spec.rfind("ismcts", 0) != 0) return nullptr;
+        return makeStrategy(spec.substr(0, slash), seed, policy);
+    }
+    if (spec.rfind("root", 0) == 0 || spec.rfind("tree", 0) == 0) {
+        ParallelMCTSConfig config;
+        config.mode = spec[0] == 'r' ? PARALLEL_ROOT : PARALLEL_TREE;
+        config.threads = spec.size() > 5 && spec[4] == ':' ? atoi(spec.c_str() + 5) : 2;
+        config.iterations = MCTSConfig{}.iterations;
+        config.nodeCapacity = 1 << 17;
+        config.rollout = rollout;
+        config.seed = seed;
+        return make_unique<ParallelMCTSStrategy>(config);
+    }
+    if (spec == "greedy") return make_unique<GreedyAIStrategy>();
+    if (spec == "random") return make_unique<RandomAIStrategy>(seed);
+    if (spec.rfind("mcts", 0) == 0) {
+        MCTSConfig config;
+        if (spec.size() > 5 && spec[4] == ':') config.iterations = atoi(spec.c_str() + 5);
+        config.rollout = rollout;
+        config.seed = seed;
+        return make_unique<MCTSStrategy>(config);
+    }
+    if (spec.rfind("ismcts", 0) == 0) {
+        ISMCTSConfig config;
+        if (spec.size() > 7 && spec[6] == ':') config.iterations = atoi(spec.c_str() + 7);
+        config.maxNodes = 1 << 18;
+        config.rollout = rollout;
+        config.seed = seed;
+        return make_unique<ISMCTSStrategy>(config);
+    }
+    if (spec.rfind("emm", 0) == 0) {
+        ExpectiminimaxConfig config;
+        if (spec.size() > 4 && spec[3] == ':') config.timeBudgetMs = atoi(spec.c_str() + 4);
+        config.tableMegabytes = 4;
+        config.seed = seed;
+        return make_unique<ExpectiminimaxStrategy>(config);
+    }
+    return nullptr;
+}
+
+// splitmix64：把 (基础种子, 局号) 打散成互不相关的对局种子
+static uint64_t mixSeed(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+/**
+ * @struct Tally
+ * @brief 一个线程的统计结果，结束后再合并，避免线程间共享计数器
+ */
+struct Tally {
+    long games = 0;
+    long winsA = 0;
+    long winsAsP1 = 0;          // A 坐先手时的胜局
+    long gamesAsP1 = 0;
+    long byVictory[4][2] = {};  // [VictoryType][0 = A 胜, 1 = B 胜]
+    long moves = 0;
+
+    void merge(const Tally& o) {
+        games += o.games; winsA += o.winsA;
+        winsAsP1 += o.winsAsP1; gamesAsP1 += o.gamesAsP1;
+        for (int v = 0; v < 4; v++) for (int w = 0; w < 2; w++) byVictory[v][w] += o.byVictory[v][w];
+        moves += o.moves;
+    }
+};
+
+/**
+ * @brief Wilson 置信区间 (95%)
+ * 胜率接近 0 或 1、局数较少时比正态近似更可靠。
+ */
+static void wilson(long wins, long n, double& lo, double& hi) {
+    if (n == 0) { lo = 0; hi = 1; return; }
+    const double z = 1.959964;
+    double p = (double)wins / n;
+    double denom = 1 + z * z / n;
+    double center = (p + z * z / (2.0 * n)) / denom;
+    double half = z * sqrt(p * (1 - p) / n + z * z / (4.0 * n * n)) / denom;
+    lo = center - half;
+    hi = center + half;
+}
+
+int main(int argc, char** argv) {
+    // 先取出 --record，其余按位置解析
+    string recordPath;
+    vector<char*> args;
+    for (int i = 0; i < argc; i++) {
+        if (strncmp(argv[i], "--record=", 9) == 0) recordPath = argv[i] + 9;
+        else args.push_back(argv[i]);
+    }
+    argc = (int)args.size();
+    argv = args.data();
+    if (argc < 3) {
+        fprintf(stderr, "用法: %s <策略A> <策略B> [局数] [线程数] [种子] [--record=<文件>]\n", argv[0]);
+        fprintf(stderr, "策略: greedy | random | mcts | mcts:<迭代次数> | emm | emm:<毫秒> | root:<线程数> | tree:<线程数> | ismcts | ismcts:<迭代次数>\n");
+        fprintf(stderr, "      MCTS 类策略后加 /<模拟策略> 选择 rollout 走子 (random | greedy | epsilon | military | science | chain)\n");
+        fprintf(stderr, "      后加 +eg 表示残局改用求解器\n");
+        return 1;
+    }
+    string specA = argv[1], specB = argv[2];
+    long games = argc > 3 ? atol(argv[3]) : 1000;
+    int threads = argc > 4 ? atoi(argv[4]) : (int)thread::hardware_concurrency();
+    uint64_t baseSeed = argc > 5 ? strtoull(argv[5], nullptr, 10) : 1;
+    if (threads <= 0) threads = 1;
+    if (!makeStrategy(specA, 0) || !makeStrategy(specB, 0)) {
+        fprintf(stderr, "未知策略: %s / %s\n", specA.c_str(), specB.c_str());
+        return 1;
+    }
+
+    atomic<long> next{0};
+    vector<Tally> tallies(threads);
+    // 每局的记录放在自己的下标处，线程之间互不干扰，结束后按局号拼接
+    vector<vector<uint8_t>> records(recordPath.empty() ? 0 : games);
+    auto worker = [&](Tally& t) {
+        for (long i; (i = next.fetch_add(1, memory_order_relaxed)) < games; ) {
+            uint64_t seed = mixSeed(baseSeed * 0x100000001B3ull + i / 2);
+            bool aFirst = (i % 2 == 0);
+            auto a = makeStrategy(specA, seed);
+            auto b = makeStrategy(specB, seed ^ 0xB);
+            shared_ptr<ReplayRecorder> recorder;
+            if (!records.empty()) {
+                recorder = make_shared<ReplayRecorder>(seed, aFirst ? 0 : 1, aFirst ? 1 : 0);
+                a = ReplayRecorder::wrap(recorder, std::move(a));
+                b = ReplayRecorder::wrap(recorder, std::move(b));
+            }
+            Game game(aFirst ? "A" : "B", aFirst ? std::move(a) : std::move(b),
+                      aFirst ? "B" : "A", aFirst ? std::move(b) : std::move(a),
+                      seed, true);
+            GameResult r = game.simulate();
+            if (recorder) recorder->append(records[i]);
+            bool aWon = (r.winner == 0) == aFirst;
+            t.games++;
+            t.moves += r.moveCount;
+            if (aWon) t.winsA++;
+            if (aFirst) { t.gamesAsP1++; if (aWon) t.winsAsP1++; }
+            t.byVictory[r.victory][aWon ? 0 : 1]++;
+        }
+    };
+
+    auto start = chrono::steady_clock::now();
+    vector<thread> pool;
+    for (int i = 0; i < threads; i++) pool.emplace_back(worker, ref(tallies[i]));
+    for (auto& th : pool) th.join();
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    Tally total;
+    for (auto& t : tallies) total.merge(t);
+
+    double lo, hi;
+    wilson(total.winsA, total.games, lo, hi);
+    printf("A = %s, B = %s, %ld 局, %d 线程, 种子 %llu\n",
+           specA.c_str(), specB.c_str(), total.games, threads, (unsigned long long)baseSeed);
+    printf("A 胜率: %.2f%% (%ld/%ld), 95%% 置信区间 [%.2f%%, %.2f%%]\n",
+           100.0 * total.winsA / total.games, total.winsA, total.games, 100 * lo, 100 * hi);
+    long gamesAsP2 = total.games - total.gamesAsP1;
+    printf("A 先手胜率: %.2f%% (%ld 局) | A 后手胜率: %.2f%% (%ld 局)\n",
+           total.gamesAsP1 ? 100.0 * total.winsAsP1 / total.gamesAsP1 : 0.0, total.gamesAsP1,
+           gamesAsP2 ? 100.0 * (total.winsA - total.winsAsP1) / gamesAsP2 : 0.0, gamesAsP2);
+    const char* victoryNames[4] = {"未结束", "军事压制", "科技压制", "终局计分"};
+    for (int v = V_MILITARY; v <= V_CIVILIAN; v++) {
+        printf("  %s: A %ld / B %ld\n", victoryNames[v], total.byVictory[v][0], total.byVictory[v][1]);
+    }
+    printf("用时 %.2f 秒, %.1f 局/秒, 平均 %.1f 步/局\n",
+           seconds, total.games / seconds, (double)total.moves / total.games);
+
+    if (!recordPath.empty()) {
+        ReplayFile file;
+        file.strategies = {specA, specB};
+        for (const auto& r : records) file.records.insert(file.records.end(), r.begin(), r.end());
+        if (!file.save(recordPath)) {
+            fprintf(stderr, "无法写入对局记录: %s\n", recordPath.c_str());
+            return 1;
+        }
+        printf("对局记录: %s, %zu 字节, 平均 %.1f 字节/局\n",
+               recordPath.c_str(), file.records.size(), (double)file.records.size() / total.games);
+    }
+    return 0;
+}